@@ -0,0 +1,114 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameplayTagContainer.h"
+#include "EnemyTemplateTypes.h"
+
+/** Flags packed into each hot ability record */
+enum class EEnemyAbilityRecordFlags : uint8
+{
+    None        = 0,
+    Passive     = 1 << 0,
+};
+ENUM_CLASS_FLAGS(EEnemyAbilityRecordFlags)
+
+/**
+ * Hot ability data
+ * Everything AI selection, range queries and validation scans, and nothing else.
+ */
+struct FEnemyAbilityRecord
+{
+    /** Ability name, used as the stable id across inheritance and modifications */
+    FName AbilityName;
+
+    /** Cooldown time in seconds */
+    float CooldownTime = 0.0f;
+
+    /** Range of the ability */
+    float Range = 0.0f;
+
+    /** Cost to use the ability */
+    float Cost = 0.0f;
+
+    /** Aura strength, meaningful when AuraType is set */
+    float AuraMagnitude = 0.0f;
+
+    /** Packed boolean state */
+    EEnemyAbilityRecordFlags Flags = EEnemyAbilityRecordFlags::None;
+
+    /** Aura projected onto nearby allies */
+    EEnemyAuraType AuraType = EEnemyAuraType::None;
+
+    /** Index of the matching entry in the cold table */
+    uint16 ColdIndex = 0;
+
+    bool IsPassive() const { return EnumHasAnyFlags(Flags, EEnemyAbilityRecordFlags::Passive); }
+    bool IsAura() const { return AuraType != EEnemyAuraType::None; }
+};
+
+static_assert(sizeof(FEnemyAbilityRecord) <= 32, "Hot ability records should stay at or under half a cache line");
+
+/**
+ * Cold ability data
+ * Presentation text and asset references, only touched when an ability is granted or displayed.
+ */
+struct FEnemyAbilityColdData
+{
+    FText DisplayName;
+    FText Description;
+    FGameplayTagContainer AbilityTags;
+    TSoftClassPtr<UGameplayAbility> AbilityClass;
+    TSoftObjectPtr<UAnimMontage> AbilityMontage;
+    TArray<TSoftClassPtr<UGameplayEffect>> AbilityEffects;
+};
+
+/**
+ * Resolved ability set split into a packed hot array and a parallel cold table
+ * Ability loops iterate Records only; the first few records are stored inline so a
+ * typical enemy's abilities sit in the owning snapshot's own cache lines.
+ */
+struct ENEMYCREATOR_API FEnemyAbilityTable
+{
+    /** Add an ability, or replace the existing one with the same name */
+    void AddOrReplace(const FEnemyAbilityDefinition& Definition);
+
+    /** Find the record index for an ability name, INDEX_NONE if missing */
+    int32 Find(FName AbilityName) const;
+
+    /** Whether an ability with this name exists */
+    bool Contains(FName AbilityName) const { return Find(AbilityName) != INDEX_NONE; }
+
+    /** Cold data for a record */
+    const FEnemyAbilityColdData& GetColdData(const FEnemyAbilityRecord& Record) const { return ColdData[Record.ColdIndex]; }
+
+    /** Rebuild a full definition for editor display or serialization */
+    FEnemyAbilityDefinition ToDefinition(int32 RecordIndex) const;
+
+    /**
+     * Pick the ready active ability with the tightest range that still reaches Distance
+     * @param CooldownRemaining   Per-record remaining cooldown, parallel to Records; empty means all ready
+     * @param AvailableResource   Resource available to pay the ability cost
+     * @return Record index or INDEX_NONE
+     */
+    int32 SelectAbilityInRange(float Distance, TArrayView<const float> CooldownRemaining, float AvailableResource) const;
+
+    /** Longest range of any active ability, 0 if none */
+    float GetMaxActiveRange() const;
+
+    int32 Num() const { return Records.Num(); }
+
+    /** Whether a record here and a record in Other describe the same ability, hot and cold data alike */
+    bool IsSameEntry(int32 RecordIndex, const FEnemyAbilityTable& Other, int32 OtherRecordIndex) const;
+
+    bool operator==(const FEnemyAbilityTable& Other) const;
+    bool operator!=(const FEnemyAbilityTable& Other) const { return !(*this == Other); }
+    friend ENEMYCREATOR_API uint32 GetTypeHash(const FEnemyAbilityTable& Table);
+
+    /** Hot records, iterated by runtime systems */
+    TArray<FEnemyAbilityRecord, TInlineAllocator<4>> Records;
+
+    /** Cold data, indexed by FEnemyAbilityRecord::ColdIndex */
+    TArray<FEnemyAbilityColdData> ColdData;
+};
@@ -0,0 +1,95 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "EnemyTemplateTypes.h"
+
+class UEnemyTemplate;
+
+/**
+ * Read-only view of a template's abilities across its inheritance chain
+ * Holds one array view per template, root first, and never copies a definition. Iteration yields every
+ * ability name once with its most-derived definition: inherited abilities first, then each level's
+ * additions. Valid while the templates in the chain are alive and unedited.
+ */
+class ENEMYCREATOR_API FEnemyAbilityView
+{
+public:
+    using FLayer = TArrayView<const FEnemyAbilityDefinition>;
+    
+    /** Gather the ability arrays of Template and its loaded ancestors */
+    explicit FEnemyAbilityView(const UEnemyTemplate& Template);
+    
+    /** Most-derived definition for an ability name, null if no layer defines it */
+    const FEnemyAbilityDefinition* Find(FName AbilityName) const;
+    
+    /** Whether any layer defines the ability */
+    bool Contains(FName AbilityName) const { return Find(AbilityName) != nullptr; }
+    
+    /** Number of distinct abilities. Walks the layers */
+    int32 Num() const;
+    
+    /** Number of templates contributing layers */
+    int32 NumLayers() const { return Layers.Num(); }
+    
+    class FConstIterator
+    {
+    public:
+        FConstIterator(const FEnemyAbilityView& InView, int32 InLayerIndex)
+            : View(InView)
+            , LayerIndex(InLayerIndex)
+            , ElementIndex(0)
+        {
+            SkipShadowed();
+        }
+        
+        FConstIterator& operator++()
+        {
+            ++ElementIndex;
+            SkipShadowed();
+            return *this;
+        }
+        
+        const FEnemyAbilityDefinition& operator*() const { return View.Layers[LayerIndex][ElementIndex]; }
+        const FEnemyAbilityDefinition* operator->() const { return &**this; }
+        
+        bool operator!=(const FConstIterator& Other) const { return LayerIndex != Other.LayerIndex || ElementIndex != Other.ElementIndex; }
+        
+    private:
+        /** Advance past exhausted layers and definitions that a more-derived layer overrides */
+        void SkipShadowed()
+        {
+            while (LayerIndex < View.Layers.Num())
+            {
+                if (ElementIndex >= View.Layers[LayerIndex].Num())
+                {
+                    ++LayerIndex;
+                    ElementIndex = 0;
+                }
+                else if (View.IsShadowed(LayerIndex, View.Layers[LayerIndex][ElementIndex].AbilityName))
+                {
+                    ++ElementIndex;
+                }
+                else
+                {
+                    break;
+                }
+            }
+        }
+        
+        const FEnemyAbilityView& View;
+        int32 LayerIndex;
+        int32 ElementIndex;
+    };
+    
+    FConstIterator begin() const { return FConstIterator(*this, 0); }
+    FConstIterator end() const { return FConstIterator(*this, Layers.Num()); }
+    
+private:
+    /** Whether a layer after LayerIndex also defines the ability */
+    bool IsShadowed(int32 LayerIndex, FName AbilityName) const;
+    
+    /** Ability arrays from the root template down to the viewed one */
+    TArray<FLayer, TInlineAllocator<8>> Layers;
+};
@@ -0,0 +1,44 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AnimationSharingTypes.h"
+#include "EnemyAnimationSharing.generated.h"
+
+class UAnimationSharingManager;
+class UAnimationSharingSetup;
+class UEnemyTemplate;
+
+/**
+ * Picks the shared state an enemy follows
+ * Attack while the enemy carries the configured attack tag, Move above the configured speed, Idle otherwise.
+ */
+UCLASS()
+class ENEMYCREATOR_API UEnemyAnimationStateProcessor : public UAnimationSharingStateProcessor
+{
+    GENERATED_BODY()
+
+public:
+    UEnemyAnimationStateProcessor();
+    
+    //~ Begin UAnimationSharingStateProcessor Interface
+    virtual void ProcessActorState_Implementation(int32& OutState, AActor* InActor, uint8 CurrentState, uint8 OnDemandState, bool& bShouldProcess) override;
+    //~ End UAnimationSharingStateProcessor Interface
+};
+
+/**
+ * Builds animation sharing setups from templates and hands out the world's sharing manager
+ * Templates on the same skeleton share one skeleton entry: each state gets every distinct animation the
+ * templates author for it, each run by a few leader instances. Followers copy a leader's pose, so a crowd
+ * of identical enemies costs about as much animation time as its leaders.
+ */
+class ENEMYCREATOR_API FEnemyAnimationSharing
+{
+public:
+    /** Rebuild a setup with one entry per skeleton the templates animate. Returns the number of skeletons */
+    static int32 BuildSetup(UAnimationSharingSetup& Setup, TConstArrayView<const UEnemyTemplate*> Templates);
+    
+    /** The world's sharing manager, created from the configured setup on first use. Null when sharing is unavailable */
+    static UAnimationSharingManager* GetManager(UWorld* World);
+};
@@ -0,0 +1,90 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameplayTagContainer.h"
+#include "EnemyTemplateTypes.h"
+
+class UEnemyTemplate;
+struct FAssetData;
+
+/** How a bulk edit combines a stat with its operand */
+enum class EEnemyBulkEditOp : uint8
+{
+    Set,
+    Add,
+    Subtract,
+    Multiply,
+    Divide
+};
+
+/** Template filter for bulk edits, matched against registry tags before loading and against the template itself after */
+struct ENEMYCREATOR_API FEnemyTemplateQuery
+{
+    /** Archetypes to match; empty matches every archetype */
+    TArray<EEnemyType, TInlineAllocator<4>> Types;
+    
+    /** Tags a template must all carry */
+    FGameplayTagContainer RequiredTags;
+    
+    /** Match a template's registry entry without loading it */
+    bool Matches(const FAssetData& AssetData) const;
+    
+    /** Match a loaded template */
+    bool Matches(const UEnemyTemplate& Template) const;
+};
+
+/**
+ * One bulk stat edit, such as "Damage *= 1.1 where Type=Ranged"
+ * Grammar: <Stat> (= | += | -= | *= | /=) <Number> [where <Condition> [and <Condition>]...]
+ * Conditions are Type=<Archetype>[|<Archetype>...] or Tag=<GameplayTag>. Stats may be written with
+ * or without the BaseStats. prefix.
+ */
+struct ENEMYCREATOR_API FEnemyBulkEditExpression
+{
+    /** Parse one expression. On failure OutError says what was wrong */
+    static bool Parse(const FString& Text, FEnemyBulkEditExpression& OutExpression, FString& OutError);
+    
+    /** Stat field of FEnemyBaseStats this expression writes */
+    FName StatName;
+    
+    EEnemyBulkEditOp Op = EEnemyBulkEditOp::Set;
+    
+    float Operand = 0.0f;
+    
+    /** Templates the edit applies to */
+    FEnemyTemplateQuery Where;
+};
+
+/** Outcome of a bulk edit */
+struct ENEMYCREATOR_API FEnemyBulkEditResult
+{
+    /** Templates the edit was evaluated over */
+    int32 NumSelected = 0;
+    
+    /** Templates whose stats actually changed */
+    int32 NumChanged = 0;
+    
+    /** Changed templates, and loaded templates inheriting stats from them, that no longer validate */
+    int32 NumInvalid = 0;
+    
+    /** Packages of the changed templates; the only ones that need saving */
+    TArray<UPackage*> TouchedPackages;
+};
+
+/**
+ * Stat edits across many templates at once
+ * The selected templates' effective stats are copied into one column per stat, every expression runs
+ * as a flat loop over its column, and only templates whose values changed are written back, inside a
+ * single undoable transaction. A template that inherited its stats takes its own copy, so the edit
+ * never leaks into unselected siblings.
+ */
+namespace EnemyBulkEdit
+{
+    /** Registry entries of every template matching any of the queries. Loads nothing */
+    ENEMYCREATOR_API void SelectTemplates(TArrayView<const FEnemyTemplateQuery> Queries, TArray<FAssetData>& OutAssets);
+    
+    /** Apply the expressions in order to the templates, then republish and revalidate only what changed. Game thread only */
+    ENEMYCREATOR_API FEnemyBulkEditResult Apply(TArrayView<UEnemyTemplate* const> Templates, TArrayView<const FEnemyBulkEditExpression> Expressions);
+}
@@ -0,0 +1,29 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Misc/Guid.h"
+
+/** Serialization versions of enemy templates and configurations. Append new entries before VersionPlusOne */
+struct ENEMYCREATOR_API FEnemyCreatorCustomVersion
+{
+    enum Type
+    {
+        /** Saved before the version was registered */
+        BeforeCustomVersionWasAdded = 0,
+        
+        /** Templates and configurations flag the blocks they override instead of holding full copies */
+        BlockOverrideFlags,
+        
+        // -----<new versions can be added above this line>-------------------------------------------------
+        VersionPlusOne,
+        LatestVersion = VersionPlusOne - 1
+    };
+    
+    /** Unique id of this version in package headers */
+    static const FGuid GUID;
+    
+private:
+    FEnemyCreatorCustomVersion() {}
+};
@@ -0,0 +1,103 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameplayTagContainer.h"
+#include "EnemyTemplateTypes.h"
+#include "EnemyResolvedTemplate.h"
+#include "EnemyCreatorListItems.generated.h"
+
+class UEnemyTemplate;
+struct FAssetData;
+
+/**
+ * One row of the creator tool's template list or tree
+ * Built from asset registry tags alone, so listing every template loads none of them. List and tree
+ * views hold these as items and only realize entry widgets for the rows on screen.
+ */
+UCLASS(BlueprintType)
+class ENEMYCREATOR_API UEnemyTemplateListItem : public UObject
+{
+    GENERATED_BODY()
+
+public:
+    /** Fill this row from a template's registry entry */
+    void InitializeFromAssetData(const FAssetData& AssetData);
+    
+    /** Template asset this row stands for */
+    UPROPERTY(BlueprintReadOnly, Category = "Template")
+    TSoftObjectPtr<UEnemyTemplate> Template;
+    
+    /** Display name, or the asset name for templates saved without one */
+    UPROPERTY(BlueprintReadOnly, Category = "Template")
+    FText DisplayName;
+    
+    UPROPERTY(BlueprintReadOnly, Category = "Template")
+    EEnemyType EnemyType = EEnemyType::Melee;
+    
+    UPROPERTY(BlueprintReadOnly, Category = "Template")
+    FGameplayTagContainer TemplateTags;
+    
+    /** Abilities including inherited ones, as of the template's last save */
+    UPROPERTY(BlueprintReadOnly, Category = "Template")
+    int32 NumAbilities = 0;
+    
+    /** Parent template, null for roots */
+    UPROPERTY(BlueprintReadOnly, Category = "Template")
+    TSoftObjectPtr<UEnemyTemplate> ParentTemplate;
+    
+    /** Templates inheriting from this one, linked once the whole list is populated */
+    UPROPERTY(BlueprintReadOnly, Category = "Template")
+    TArray<TObjectPtr<UEnemyTemplateListItem>> Children;
+    
+    /** Content hash of the template's visuals as of its last save, 0 if unknown. Keys its thumbnail */
+    uint64 VisualHash = 0;
+};
+
+/**
+ * One row of the creator tool's ability list
+ * Refers into a resolved ability table instead of copying the definition. Hot fields are read directly;
+ * presentation text is only looked up for rows an entry widget asks about.
+ */
+UCLASS(BlueprintType)
+class ENEMYCREATOR_API UEnemyAbilityListItem : public UObject
+{
+    GENERATED_BODY()
+
+public:
+    /** Point this row at a record of a resolved ability table */
+    void Initialize(const FEnemyAbilitiesFacet& InAbilities, int32 InRecordIndex);
+    
+    UFUNCTION(BlueprintPure, Category = "Ability")
+    FName GetAbilityName() const;
+    
+    UFUNCTION(BlueprintPure, Category = "Ability")
+    float GetCooldownTime() const;
+    
+    UFUNCTION(BlueprintPure, Category = "Ability")
+    float GetRange() const;
+    
+    UFUNCTION(BlueprintPure, Category = "Ability")
+    float GetCost() const;
+    
+    UFUNCTION(BlueprintPure, Category = "Ability")
+    bool IsPassive() const;
+    
+    /** Display name from the cold table */
+    UFUNCTION(BlueprintPure, Category = "Ability")
+    FText GetDisplayName() const;
+    
+    /** Full definition, for the property panel of the selected row only */
+    UFUNCTION(BlueprintPure, Category = "Ability")
+    FEnemyAbilityDefinition GetDefinition() const;
+
+private:
+    /** Hot record this row shows */
+    const FEnemyAbilityRecord* GetRecord() const;
+    
+    /** Table the record lives in, kept alive by this row while it is listed */
+    TSharedPtr<const FEnemyAbilityTable, ESPMode::ThreadSafe> Abilities;
+    
+    int32 RecordIndex = INDEX_NONE;
+};
@@ -0,0 +1,32 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Misc/MemStack.h"
+
+/**
+ * Scoped linear arena for transient EnemyCreator work
+ * Wraps the calling thread's FMemStack. Containers using the scratch aliases below allocate by bumping
+ * a pointer and are released together when the outermost scope ends, so aura pulses and library
+ * validation never touch the global allocator for their working data. Scopes nest freely.
+ */
+class FEnemyCreatorScratchScope : public FNoncopyable
+{
+public:
+    FEnemyCreatorScratchScope()
+        : Mark(FMemStack::Get())
+    {
+    }
+
+private:
+    FMemMark Mark;
+};
+
+/** Transient array allocated from the current scratch scope */
+template <typename ElementType>
+using TEnemyScratchArray = TArray<ElementType, TMemStackAllocator<>>;
+
+/** Transient map allocated from the current scratch scope */
+template <typename KeyType, typename ValueType>
+using TEnemyScratchMap = TMap<KeyType, ValueType, TMemStackSetAllocator<>>;
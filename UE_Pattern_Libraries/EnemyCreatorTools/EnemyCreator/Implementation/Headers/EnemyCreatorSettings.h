@@ -0,0 +1,130 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DeveloperSettings.h"
+#include "GameplayTagContainer.h"
+#include "AttributeSet.h"
+#include "EnemyCreatorSettings.generated.h"
+
+class UGameplayEffect;
+class UAnimationSharingSetup;
+class UAnimSharingStateInstance;
+class UAnimSharingTransitionInstance;
+
+/**
+ * Project settings for the enemy creator runtime
+ * Stored in DefaultGame.ini so cooked builds and the editor agree on every mapping defined here.
+ */
+UCLASS(Config = Game, DefaultConfig, meta = (DisplayName = "Enemy Creator"))
+class ENEMYCREATOR_API UEnemyCreatorSettings : public UDeveloperSettings
+{
+    GENERATED_BODY()
+
+public:
+    /** Get the settings object */
+    static const UEnemyCreatorSettings* Get() { return GetDefault<UEnemyCreatorSettings>(); }
+    
+    /**
+     * Gameplay tags packed into runtime trait masks, one bit each in array order
+     * Reordering entries changes bit assignments; append new tags at the end.
+     */
+    UPROPERTY(Config, EditAnywhere, Category = "Traits")
+    TArray<FGameplayTag> TraitTags;
+    
+    /**
+     * Difficulty tiers from easiest to hardest. Every resolved template precomputes stats for each one
+     * Template DifficultyMultipliers apply once per tier step away from the default tier.
+     */
+    UPROPERTY(Config, EditAnywhere, Category = "Difficulty")
+    TArray<FName> DifficultyTiers;
+    
+    /** Index of the tier whose stats equal the authored base stats */
+    UPROPERTY(Config, EditAnywhere, Category = "Difficulty", meta = (ClampMin = "0"))
+    int32 DefaultDifficultyTier = 0;
+    
+    /** Cell edge of the runtime registry's spatial hash. Close to the most common query radius works best */
+    UPROPERTY(Config, EditAnywhere, Category = "Spatial", meta = (ClampMin = "100.0", Units = "cm"))
+    float SpatialCellSize = 600.0f;
+    
+    /** Attribute read for boss phase health thresholds, measured against the resolved Health stat */
+    UPROPERTY(Config, EditAnywhere, Category = "Phases")
+    FGameplayAttribute HealthAttribute;
+    
+    /** Instant effect applied once per pulse with the combined heal of every aura reaching the recipient */
+    UPROPERTY(Config, EditAnywhere, Category = "Auras")
+    TSoftClassPtr<UGameplayEffect> HealAuraEffect;
+    
+    /** Infinite effect holding the combined buff of every aura reaching the recipient; reapplied only when the total changes */
+    UPROPERTY(Config, EditAnywhere, Category = "Auras")
+    TSoftClassPtr<UGameplayEffect> BuffAuraEffect;
+    
+    /** SetByCaller tag the aura effects read their combined magnitude from */
+    UPROPERTY(Config, EditAnywhere, Category = "Auras")
+    FGameplayTag AuraMagnitudeTag;
+    
+    /** Seconds between aura pulses */
+    UPROPERTY(Config, EditAnywhere, Category = "Auras", meta = (ClampMin = "0.05", Units = "s"))
+    float AuraPulseInterval = 1.0f;
+    
+    /** Seconds between montage residency passes */
+    UPROPERTY(Config, EditAnywhere, Category = "Montages", meta = (ClampMin = "0.05", Units = "s"))
+    float MontageResidencyInterval = 0.25f;
+    
+    /** An ability's montage loads once its cooldown has at most this long left, and a boss phase's this long before its time trigger */
+    UPROPERTY(Config, EditAnywhere, Category = "Montages", meta = (ClampMin = "0.0", Units = "s"))
+    float MontagePrefetchLeadTime = 2.0f;
+    
+    /** An ability's montage loads once the enemy's focus target is within the ability's range plus this distance */
+    UPROPERTY(Config, EditAnywhere, Category = "Montages", meta = (ClampMin = "0.0", Units = "cm"))
+    float MontagePrefetchDistance = 1500.0f;
+    
+    /** A boss phase's montages load once health is within this fraction above its threshold */
+    UPROPERTY(Config, EditAnywhere, Category = "Montages", meta = (ClampMin = "0.0", ClampMax = "1.0"))
+    float PhasePrefetchHealthMargin = 0.1f;
+    
+    /** Montages no enemy has needed for this long are released */
+    UPROPERTY(Config, EditAnywhere, Category = "Montages", meta = (ClampMin = "0.0", Units = "s"))
+    float MontageEvictionDelay = 15.0f;
+    
+    /** Sharing setup the world's animation sharing manager is created from. Regenerated from templates by the enemy creator tool */
+    UPROPERTY(Config, EditAnywhere, Category = "Animation Sharing")
+    TSoftObjectPtr<UAnimationSharingSetup> AnimationSharingSetup;
+    
+    /** Anim blueprint each leader runs to play its state's animation */
+    UPROPERTY(Config, EditAnywhere, Category = "Animation Sharing")
+    TSoftClassPtr<UAnimSharingStateInstance> SharedStateAnimClass;
+    
+    /** Anim blueprint blending followers between leaders when their state changes */
+    UPROPERTY(Config, EditAnywhere, Category = "Animation Sharing")
+    TSoftClassPtr<UAnimSharingTransitionInstance> SharedBlendAnimClass;
+    
+    /** Tag an enemy carries while attacking; sharing followers play the shared attack while it is present */
+    UPROPERTY(Config, EditAnywhere, Category = "Animation Sharing")
+    FGameplayTag AttackAnimationTag;
+    
+    /** Ground speed above which sharing followers play the shared move state */
+    UPROPERTY(Config, EditAnywhere, Category = "Animation Sharing", meta = (ClampMin = "0.0", Units = "cm/s"))
+    float MoveAnimationSpeed = 10.0f;
+    
+    /** Time per editor tick the creator tool spends turning asset registry entries into template list rows */
+    UPROPERTY(Config, EditAnywhere, Category = "Creator Tool", meta = (ClampMin = "0.1", Units = "ms"))
+    float TemplateListBudgetMs = 2.0f;
+    
+    /** Edge length of template browser thumbnails */
+    UPROPERTY(Config, EditAnywhere, Category = "Creator Tool", meta = (ClampMin = "32", ClampMax = "1024", Units = "px"))
+    int32 ThumbnailSize = 128;
+    
+    /** Offscreen scenes thumbnails are captured in; each has at most one capture in flight */
+    UPROPERTY(Config, EditAnywhere, Category = "Creator Tool", meta = (ClampMin = "1", ClampMax = "8"))
+    int32 NumThumbnailScenes = 2;
+    
+    /** Time per editor tick the thumbnail renderer spends starting loads and captures */
+    UPROPERTY(Config, EditAnywhere, Category = "Creator Tool", meta = (ClampMin = "0.1", Units = "ms"))
+    float ThumbnailBudgetMs = 1.0f;
+    
+    /** Thumbnails kept in memory before the oldest are released; released ones reload from the disk cache */
+    UPROPERTY(Config, EditAnywhere, Category = "Creator Tool", meta = (ClampMin = "16"))
+    int32 MaxCachedThumbnails = 512;
+};
@@ -3,8 +3,21 @@
 #include "CoreMinimal.h"
 #include "EnemyCreatorTypes.h"
 #include "EnemyTemplate.h"
+#include "AssetRegistry/AssetData.h"
+#include "Containers/Ticker.h"
 #include "EnemyCreatorTool.generated.h"
 
+class UEnemyTemplateListItem;
+class UEnemyAbilityListItem;
+class UTexture2D;
+class FEnemyThumbnailRenderer;
+struct FStreamableHandle;
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnEnemyTemplateItemsAdded, const TArray<UEnemyTemplateListItem*>&, Items);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE(FOnEnemyTemplateListPopulated);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnEnemyTemplateOpened, UEnemyTemplate*, Template);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnEnemyThumbnailReady, UObject*, Source, UTexture2D*, Thumbnail);
+
 UCLASS(BlueprintType)
 class ENEMYCREATOR_API UEnemyCreatorTool : public UObject
 {
@@ -13,6 +26,10 @@ class ENEMYCREATOR_API UEnemyCreatorTool : public UObject
 public:
     UEnemyCreatorTool();
     
+    //~ Begin UObject Interface
+    virtual void BeginDestroy() override;
+    //~ End UObject Interface
+    
     //~ Begin Template Management
     /** Create a new enemy template */
     UFUNCTION(BlueprintCallable, Category = "Enemy Creation")
@@ -27,6 +44,96 @@ public:
     void UpdatePreview(UEnemyConfiguration* Config);
     //~ End Template Management
     
+    //~ Begin Template Browser
+    /**
+     * Rebuild the template list from the asset registry without loading any template
+     * Rows are created a time slice per tick and announced through OnTemplateItemsAdded, so list views
+     * can show the first rows at once. Waits for the registry's initial scan if it is still running.
+     */
+    UFUNCTION(BlueprintCallable, Category = "Template Browser")
+    void RefreshTemplateList();
+    
+    /** Whether every registry entry has a row and the inheritance tree is linked */
+    UFUNCTION(BlueprintPure, Category = "Template Browser")
+    bool IsTemplateListPopulated() const { return bTemplateListPopulated; }
+    
+    /** Children of a template row, for a tree view's item children callback */
+    UFUNCTION(BlueprintCallable, Category = "Template Browser")
+    void GetTemplateChildren(UObject* Item, TArray<UObject*>& OutChildren) const;
+    
+    /** Stream a template in and list its resolved abilities; OnTemplateOpened fires once it is loaded */
+    UFUNCTION(BlueprintCallable, Category = "Template Browser")
+    void OpenTemplate(UEnemyTemplateListItem* Item);
+    
+    /** New template rows, in asset name order */
+    UPROPERTY(BlueprintAssignable, Category = "Template Browser")
+    FOnEnemyTemplateItemsAdded OnTemplateItemsAdded;
+    
+    /** The template list and tree are complete */
+    UPROPERTY(BlueprintAssignable, Category = "Template Browser")
+    FOnEnemyTemplateListPopulated OnTemplateListPopulated;
+    
+    /** A template opened with OpenTemplate is loaded and AbilityItems lists its abilities */
+    UPROPERTY(BlueprintAssignable, Category = "Template Browser")
+    FOnEnemyTemplateOpened OnTemplateOpened;
+    
+    /**
+     * Thumbnail of a template row, for entry widgets to call as they scroll into view
+     * Returns the thumbnail if it is in memory. Otherwise returns null and OnThumbnailReady fires once it has been
+     * read from the disk cache or rendered offscreen; the preview actor is never touched. Asking again while the
+     * row is pending does not queue it twice. Call ReleaseThumbnail when the row scrolls out of view.
+     */
+    UFUNCTION(BlueprintCallable, Category = "Template Browser")
+    UTexture2D* RequestThumbnail(UEnemyTemplateListItem* Item);
+    
+    /** Thumbnail of a configuration, with its modifications applied. Same contract as RequestThumbnail */
+    UFUNCTION(BlueprintCallable, Category = "Template Browser")
+    UTexture2D* RequestConfigurationThumbnail(UEnemyConfiguration* Configuration);
+    
+    /** Stop waiting on the thumbnail of a row or configuration, such as when its entry widget is released. OnThumbnailReady will not fire for it */
+    UFUNCTION(BlueprintCallable, Category = "Template Browser")
+    void ReleaseThumbnail(UObject* Source);
+    
+    /**
+     * Cancel every thumbnail request and tear down the offscreen scenes
+     * Call when the template browser closes. A tool destroyed without it hands the renderer to the next
+     * ticker tick, since its scenes cannot be torn down from inside garbage collection.
+     */
+    UFUNCTION(BlueprintCallable, Category = "Template Browser")
+    void ShutdownThumbnails();
+    
+    /** A thumbnail requested for a template row or configuration exists, or is null if it could not be produced */
+    UPROPERTY(BlueprintAssignable, Category = "Template Browser")
+    FOnEnemyThumbnailReady OnThumbnailReady;
+    //~ End Template Browser
+    
+    //~ Begin Bulk Editing
+    /**
+     * Apply stat expressions such as "Damage *= 1.1 where Type=Ranged" to every matching template as one undo step
+     * Expressions are separated by ';' or new lines and run in order. Templates are selected from registry
+     * tags, so only matching ones are loaded. Returns the number of templates changed, or INDEX_NONE if an
+     * expression does not parse.
+     */
+    UFUNCTION(BlueprintCallable, Category = "Bulk Editing")
+    int32 BulkEditTemplates(const FString& Expressions, bool bSaveChangedPackages = false);
+    //~ End Bulk Editing
+    
+    //~ Begin Review
+    /** Field-by-field differences between two templates, one line each. Pass a template's parent as Before to see what it overrides */
+    UFUNCTION(BlueprintCallable, Category = "Review")
+    FString DiffTemplates(UEnemyTemplate* Before, UEnemyTemplate* After) const;
+    
+    /** Field-by-field differences a configuration makes to its base template, one line each */
+    UFUNCTION(BlueprintCallable, Category = "Review")
+    FString DiffConfiguration(UEnemyConfiguration* Configuration) const;
+    //~ End Review
+    
+    //~ Begin Runtime Setup
+    /** Rebuild the configured animation sharing setup from every template's sharing states. Returns the number of skeletons */
+    UFUNCTION(BlueprintCallable, Category = "Animation Sharing")
+    int32 GenerateAnimationSharingSetup();
+    //~ End Runtime Setup
+    
     //~ Begin AI Features
     /** Simulate AI behavior in preview */
     UFUNCTION(BlueprintCallable, Category = "AI")
@@ -53,6 +160,37 @@ protected:
     void RegisterAICallbacks();
     //~ End UI Components
     
+    //~ Begin Template Defaults
+    /** Fill type-specific stats, AI, tags and visuals */
+    void InitializeTemplateDefaults(class FEnemyTemplateBuilder& Builder, EEnemyType EnemyType);
+    
+    /** Load the default mesh, animation blueprint and behavior tree for a type */
+    void LoadDefaultAssets(class FEnemyTemplateBuilder& Builder, EEnemyType EnemyType);
+    
+    /** Add the default ability set for a type */
+    void LoadDefaultAbilities(class FEnemyTemplateBuilder& Builder, EEnemyType EnemyType);
+    //~ End Template Defaults
+    
+    //~ Begin Template Browser Helpers
+    /** Create rows for pending registry entries until the time slice runs out. Returns false once every entry has a row */
+    bool PopulateTemplateList(float DeltaTime);
+    
+    /** Attach every row to its parent's children and collect the roots */
+    void LinkTemplateTree();
+    
+    /** Stop any population in progress and forget pending entries */
+    void CancelTemplateListPopulation();
+    
+    /** Called when the template requested by OpenTemplate finishes loading */
+    void OnOpenedTemplateLoaded();
+    
+    /** Thumbnail renderer, created on first request */
+    FEnemyThumbnailRenderer& GetThumbnailRenderer();
+    
+    /** Callback broadcasting OnThumbnailReady for Source and forgetting its pending request */
+    FOnEnemyThumbnailRendered MakeThumbnailCallback(UObject* Source);
+    //~ End Template Browser Helpers
+    
     //~ Begin Callbacks
     /** Called when behavior tree is generated */
     UFUNCTION()
@@ -75,4 +213,42 @@ protected:
     /** Property customization widget */
     UPROPERTY()
     class UEnemyPropertyCustomization* PropertyCustomization;
+    
+    /** Every template row, in asset name order. Feed to a list view as is */
+    UPROPERTY(BlueprintReadOnly, Category = "Template Browser")
+    TArray<TObjectPtr<UEnemyTemplateListItem>> TemplateItems;
+    
+    /** Rows whose parent is not listed, for a tree view. Filled once the list is populated */
+    UPROPERTY(BlueprintReadOnly, Category = "Template Browser")
+    TArray<TObjectPtr<UEnemyTemplateListItem>> RootTemplateItems;
+    
+    /** Resolved abilities of the opened template, one row per record */
+    UPROPERTY(BlueprintReadOnly, Category = "Template Browser")
+    TArray<TObjectPtr<UEnemyAbilityListItem>> AbilityItems;
+    
+private:
+    /** Registry entries still waiting for a row */
+    TArray<FAssetData> PendingTemplateAssets;
+    
+    /** Next entry of PendingTemplateAssets to turn into a row */
+    int32 NextPendingAsset = 0;
+    
+    bool bTemplateListPopulated = false;
+    
+    FTSTicker::FDelegateHandle PopulateTickerHandle;
+    
+    /** Registered while waiting for the registry's initial scan */
+    FDelegateHandle FilesLoadedHandle;
+    
+    /** Keeps the opened template loaded */
+    TSharedPtr<FStreamableHandle> OpenedTemplateHandle;
+    
+    /** Template requested by the last OpenTemplate */
+    TSoftObjectPtr<UEnemyTemplate> OpenedTemplate;
+    
+    /** Offscreen thumbnail rendering and caching for the template browser */
+    TSharedPtr<FEnemyThumbnailRenderer> ThumbnailRenderer;
+    
+    /** Pending thumbnail request per row or configuration, for ReleaseThumbnail */
+    TMap<TWeakObjectPtr<UObject>, uint32> ThumbnailRequests;
 }; 
\ No newline at end of file
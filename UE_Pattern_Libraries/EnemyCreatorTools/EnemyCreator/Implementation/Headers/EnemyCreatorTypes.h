@@ -2,17 +2,18 @@
 
 #include "CoreMinimal.h"
 #include "EnemyTemplateTypes.h"
+#include "EnemyResolvedTemplate.h"
 #include "EnemyCreatorTypes.generated.h"
 
-UENUM(BlueprintType)
-enum class EEnemyType : uint8
+/** Asset registry tags published by every enemy configuration, readable without loading it */
+namespace EnemyConfigurationTags
 {
-    Melee       UMETA(DisplayName = "Melee"),
-    Ranged      UMETA(DisplayName = "Ranged"),
-    Support     UMETA(DisplayName = "Support"),
-    Elite       UMETA(DisplayName = "Elite"),
-    Boss        UMETA(DisplayName = "Boss")
-};
+    extern ENEMYCREATOR_API const FName Points;
+    extern ENEMYCREATOR_API const FName SpawnCostMs;
+    extern ENEMYCREATOR_API const FName RuntimeCostMs;
+    extern ENEMYCREATOR_API const FName MemoryBytes;
+    extern ENEMYCREATOR_API const FName GameplayTags;
+}
 
 /** Configuration for enemy instances */
 UCLASS(BlueprintType)
@@ -24,18 +25,69 @@ public:
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Configuration")
     TSoftObjectPtr<UEnemyTemplate> BaseTemplate;
     
-    /** Template modifications */
-    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Configuration")
-    FEnemyTemplateModification Modifications;
+    /** Measured cost of one instance, published to the asset registry for encounter budgeting */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Cost")
+    FEnemyCostReport CostReport;
     
-    /** Initialize from template */
+    //~ Begin UObject Interface
+    virtual void Serialize(FArchive& Ar) override;
+    virtual void PostLoad() override;
+    virtual void GetAssetRegistryTags(TArray<FAssetRegistryTag>& OutTags) const override;
+    virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+    //~ End UObject Interface
+    
+    /** Initialize from template. Shares every template block; nothing is copied until it is edited */
     void InitializeFromTemplate(UEnemyTemplate* Template);
     
+    /** Get the template modifications */
+    const FEnemyTemplateModification& GetModifications() const { return Modifications; }
+    
+    /** Replace the template modifications and drop the cached resolved view */
+    UFUNCTION(BlueprintCallable, Category = "Configuration")
+    void SetModifications(const FEnemyTemplateModification& NewModifications);
+    
+    /** Detach the AI block from the template on first call and return it for editing */
+    FEnemyAIConfig& EditAIConfig();
+    
+    /** Detach the visual block from the template on first call and return it for editing */
+    FEnemyVisualCustomization& EditVisuals();
+    
+    /**
+     * Get the resolved view of this configuration. Game thread only
+     * Returns the template's own snapshot when nothing is modified; otherwise a variant that shares
+     * every facet this configuration does not override.
+     */
+    FEnemyResolvedTemplatePtr GetResolvedConfiguration() const;
+    
     /** Apply configuration to an enemy instance */
     bool ApplyConfiguration(class ABaseEnemy* Enemy);
     
+    /**
+     * Apply configuration to an enemy instance as an elite with the given affixes
+     * The composition comes from the world registry's elite composer, so every pack rolling the same affixes on
+     * this configuration shares one resolved snapshot. Without affixes this is ApplyConfiguration.
+     */
+    bool ApplyEliteConfiguration(class ABaseEnemy* Enemy, TArrayView<const class UEnemyEliteAffix* const> Affixes);
+    
+    /** Apply configuration to a whole wave, resolving it once for every enemy. Returns the number of enemies configured */
+    int32 ApplyConfigurationToWave(TArrayView<class ABaseEnemy* const> Enemies);
+    
     /** Validate configuration */
     bool ValidateConfiguration(FEnemyTemplateValidationResult& OutResult) const;
+    
+protected:
+    /** Template modifications. Written only through SetModifications and the Edit accessors, which keep CachedResolved current */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Configuration")
+    FEnemyTemplateModification Modifications;
+    
+    /** Drop the cached resolved view after an edit */
+    void InvalidateResolvedConfiguration() { CachedResolved.Reset(); }
+    
+    /** Cached resolved view */
+    mutable FEnemyResolvedTemplatePtr CachedResolved;
+    
+    /** Serial of the template snapshot CachedResolved was built from */
+    mutable uint32 CachedTemplateSerial = 0;
 };
 
 /** Preview actor for enemy templates */
@@ -0,0 +1,30 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+DECLARE_MULTICAST_DELEGATE_OneParam(FOnEnemyDifficultyTierChanged, int32 /*NewTier*/);
+
+/**
+ * Process-wide difficulty switch
+ * The active tier is an index into the per-tier stat tables every resolved template precomputes, so
+ * changing it never resolves anything; listeners swap to the new index in one pass.
+ */
+namespace EnemyDifficulty
+{
+    /** Number of tiers configured in project settings, at least one */
+    ENEMYCREATOR_API int32 GetNumTiers();
+    
+    /** Tier whose stats equal the authored base stats */
+    ENEMYCREATOR_API int32 GetDefaultTier();
+    
+    /** Active tier. Safe to call from any thread */
+    ENEMYCREATOR_API int32 GetActiveTier();
+    
+    /** Switch the active tier and notify listeners. Game thread only */
+    ENEMYCREATOR_API void SetActiveTier(int32 Tier);
+    
+    /** Broadcast on the game thread after the active tier changes */
+    ENEMYCREATOR_API FOnEnemyDifficultyTierChanged& OnTierChanged();
+}
@@ -0,0 +1,79 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameplayEffect.h"
+
+class UAbilitySystemComponent;
+
+/**
+ * Shared gameplay effect specs keyed by effect class, level and source object
+ * Template effects are self-applied, so the spec for a key is built once per world and copied once per
+ * batch instead of being built per enemy per effect. Each target still gets its own context from
+ * MakeEffectContext, so cues and executions see the enemy as instigator and causer. Effects that capture
+ * source attributes depend on who applies them and are built per target instead.
+ */
+class ENEMYCREATOR_API FEnemyEffectSpecPool
+{
+public:
+    /** Shared spec for a key, built on first use. Null if the effect cannot be shared */
+    const FGameplayEffectSpec* Acquire(TSubclassOf<UGameplayEffect> EffectClass, float Level, const UObject* SourceObject);
+    
+    /** Apply an effect to one ability system */
+    void ApplyToTarget(UAbilitySystemComponent* Target, TSubclassOf<UGameplayEffect> EffectClass, float Level, const UObject* SourceObject);
+    
+    /** Apply one effect to many ability systems, resolving the spec once. Returns the number of targets applied to */
+    int32 ApplyToTargets(TArrayView<UAbilitySystemComponent* const> Targets, TSubclassOf<UGameplayEffect> EffectClass, float Level, const UObject* SourceObject);
+    
+    /**
+     * Apply one effect to many ability systems, each with its own SetByCaller magnitude
+     * The shared spec is copied once for the batch and only the magnitude changes between targets.
+     * @param OutHandles   Optional, receives the active handle per target
+     */
+    void ApplyToTargetsWithMagnitudes(TArrayView<UAbilitySystemComponent* const> Targets, TArrayView<const float> Magnitudes, const FGameplayTag& MagnitudeTag, TSubclassOf<UGameplayEffect> EffectClass, float Level, const UObject* SourceObject, TArrayView<FActiveGameplayEffectHandle> OutHandles = TArrayView<FActiveGameplayEffectHandle>());
+    
+    /** Drop every pooled spec */
+    void Reset() { Entries.Reset(); }
+    
+    /** Number of pooled keys */
+    int32 Num() const { return Entries.Num(); }
+    
+    /** Report the objects pooled specs refer to. The owner must forward its own reference collection here */
+    void AddReferencedObjects(FReferenceCollector& Collector);
+    
+private:
+    struct FKey
+    {
+        TObjectKey<UClass> EffectClass;
+        TObjectKey<UObject> SourceObject;
+        float Level = 1.0f;
+        
+        bool operator==(const FKey& Other) const
+        {
+            return EffectClass == Other.EffectClass && SourceObject == Other.SourceObject && Level == Other.Level;
+        }
+        
+        friend uint32 GetTypeHash(const FKey& Key)
+        {
+            return HashCombineFast(HashCombineFast(GetTypeHash(Key.EffectClass), GetTypeHash(Key.SourceObject)), GetTypeHash(Key.Level));
+        }
+    };
+    
+    struct FEntry
+    {
+        /** Shared spec; null when the effect captures source attributes */
+        TUniquePtr<FGameplayEffectSpec> Spec;
+        
+        /** Guards against a class being unloaded and its key reused */
+        TWeakObjectPtr<UClass> EffectClass;
+    };
+    
+    /** Build a spec that is not tied to any applying ability system */
+    static TUniquePtr<FGameplayEffectSpec> BuildSharedSpec(const UGameplayEffect& Effect, float Level, const UObject* SourceObject);
+    
+    /** Give a batch copy of a shared spec the target's own context, as MakeOutgoingSpec would have */
+    static void SetTargetContext(FGameplayEffectSpec& Spec, UAbilitySystemComponent& Target, const UObject* SourceObject);
+    
+    TMap<FKey, FEntry> Entries;
+};
@@ -0,0 +1,76 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DataAsset.h"
+#include "GameplayTagContainer.h"
+#include "EnemyTemplateTypes.h"
+#include "EnemyEliteAffix.generated.h"
+
+class UEnemyEliteAffix;
+
+DECLARE_MULTICAST_DELEGATE_OneParam(FOnEnemyEliteAffixChanged, const UEnemyEliteAffix& /*Affix*/);
+
+/**
+ * One elite modifier that can be rolled onto any enemy
+ * Affixes compose: stat multipliers and tints multiply, abilities and tags are added.
+ */
+UCLASS(BlueprintType)
+class ENEMYCREATOR_API UEnemyEliteAffix : public UDataAsset
+{
+    GENERATED_BODY()
+
+public:
+    //~ Begin UObject Interface
+    virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+    //~ End UObject Interface
+    
+    /** Broadcast on the game thread after any affix is edited, so memoized compositions using it can be dropped */
+    static FOnEnemyEliteAffixChanged& OnAffixChanged();
+    
+    //~ Begin Property Accessors
+    /** Get the name shown to players */
+    FText GetDisplayName() const { return DisplayName; }
+    
+    /** Get the stat multipliers, keyed by FEnemyBaseStats field name */
+    const TMap<FName, float>& GetStatMultipliers() const { return StatMultipliers; }
+    
+    /** Get the abilities this affix grants */
+    const TArray<FEnemyAbilityDefinition>& GetGrantedAbilities() const { return GrantedAbilities; }
+    
+    /** Get the tint multiplied into the enemy's color */
+    const FLinearColor& GetColorTint() const { return ColorTint; }
+    
+    /** Get the uniform scale multiplier */
+    float GetScaleMultiplier() const { return ScaleMultiplier; }
+    
+    /** Get the tags added to the enemy */
+    const FGameplayTagContainer& GetAffixTags() const { return AffixTags; }
+    //~ End Property Accessors
+    
+protected:
+    /** Name shown to players */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Affix")
+    FText DisplayName;
+    
+    /** Stat multipliers, keyed by FEnemyBaseStats field name */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Affix")
+    TMap<FName, float> StatMultipliers;
+    
+    /** Abilities granted in addition to the template's, replacing any with the same name */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Affix")
+    TArray<FEnemyAbilityDefinition> GrantedAbilities;
+    
+    /** Tags added to the enemy */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Affix")
+    FGameplayTagContainer AffixTags;
+    
+    /** Tint multiplied into the enemy's color */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Visual")
+    FLinearColor ColorTint = FLinearColor::White;
+    
+    /** Uniform scale multiplier */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Visual", meta = (ClampMin = "0.1"))
+    float ScaleMultiplier = 1.0f;
+};
@@ -0,0 +1,70 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "EnemyResolvedTemplate.h"
+
+class UEnemyEliteAffix;
+
+/**
+ * Composes elite affixes onto resolved templates and memoizes the results
+ * A composition is keyed by the base snapshot's serial and the affix assets' paths, so any pack that rolls
+ * the same combination on the same template reuses one resolved snapshot. Affix order does not matter.
+ * Composition applies the template's EliteMultipliers once, then every affix. Game thread only.
+ */
+class ENEMYCREATOR_API FEnemyEliteComposer
+{
+public:
+    /** Resolved template with the affixes applied. Returns Base itself when there are no affixes */
+    FEnemyResolvedTemplateRef Compose(const FEnemyResolvedTemplateRef& Base, TArrayView<const UEnemyEliteAffix* const> Affixes);
+    
+    /** Drop compositions whose base snapshot is no longer referenced */
+    void Compact();
+    
+    /** Drop every composition that includes an affix, after the affix was edited */
+    void InvalidateAffix(const UEnemyEliteAffix& Affix);
+    
+    /** Drop every composition */
+    void Reset() { Entries.Reset(); }
+    
+    /** Number of memoized compositions */
+    int32 Num() const { return Entries.Num(); }
+    
+private:
+    using FAffixSet = TArray<FSoftObjectPath, TInlineAllocator<4>>;
+    
+    struct FKey
+    {
+        uint32 BaseSerial = 0;
+        FAffixSet Affixes;
+        
+        bool operator==(const FKey& Other) const { return BaseSerial == Other.BaseSerial && Affixes == Other.Affixes; }
+        
+        friend uint32 GetTypeHash(const FKey& Key)
+        {
+            uint32 Hash = Key.BaseSerial;
+            for (const FSoftObjectPath& Affix : Key.Affixes)
+            {
+                Hash = HashCombineFast(Hash, GetTypeHash(Affix));
+            }
+            return Hash;
+        }
+    };
+    
+    struct FEntry
+    {
+        /** Lets Compact find compositions of replaced snapshots */
+        TWeakPtr<const FEnemyResolvedTemplate, ESPMode::ThreadSafe> Base;
+        
+        FEnemyResolvedTemplateRef Composed;
+    };
+    
+    /** Build a composition from affixes already sorted and deduplicated */
+    static FEnemyResolvedTemplateRef Build(const FEnemyResolvedTemplateRef& Base, TArrayView<const UEnemyEliteAffix* const> SortedAffixes);
+    
+    TMap<FKey, FEntry> Entries;
+    
+    /** Entry count that triggers the next automatic compaction */
+    int32 CompactThreshold = 64;
+};
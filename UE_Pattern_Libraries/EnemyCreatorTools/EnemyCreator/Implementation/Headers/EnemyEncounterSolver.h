@@ -0,0 +1,120 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameplayTagContainer.h"
+#include "EnemyTemplateTypes.h"
+#include "EnemyEncounterSolver.generated.h"
+
+struct FAssetData;
+class UEnemyConfiguration;
+
+/** Limits an encounter must fit. A cost limit of zero leaves that cost unconstrained */
+USTRUCT(BlueprintType)
+struct ENEMYCREATOR_API FEnemyEncounterBudget
+{
+    GENERATED_BODY()
+    
+    /** Encounter points to fill */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Budget", meta = (ClampMin = "0.0"))
+    float Points = 10.0f;
+    
+    /** Total game thread time to spawn the encounter, in milliseconds */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Budget", meta = (ClampMin = "0.0"))
+    float SpawnCostMs = 0.0f;
+    
+    /** Game thread time per frame for every enemy together, in milliseconds */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Budget", meta = (ClampMin = "0.0"))
+    float RuntimeCostMs = 0.0f;
+    
+    /** Resident memory for the distinct configurations used */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Budget", meta = (ClampMin = "0"))
+    int64 MemoryBytes = 0;
+    
+    /** Most enemies in the encounter */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Budget", meta = (ClampMin = "0"))
+    int32 MaxEnemies = 0;
+    
+    /** Most instances of any one configuration */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Budget", meta = (ClampMin = "0"))
+    int32 MaxPerConfiguration = 0;
+    
+    /** Configurations must carry all of these tags */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Constraints")
+    FGameplayTagContainer RequiredTags;
+    
+    /** Configurations carrying any of these tags are excluded */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Constraints")
+    FGameplayTagContainer BlockedTags;
+};
+
+/** One configuration in a spawn manifest */
+USTRUCT(BlueprintType)
+struct ENEMYCREATOR_API FEnemySpawnManifestEntry
+{
+    GENERATED_BODY()
+    
+    /** Configuration to spawn */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Manifest")
+    TSoftObjectPtr<UEnemyConfiguration> Configuration;
+    
+    /** Number of instances */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Manifest")
+    int32 Count = 0;
+};
+
+/** Solved encounter and the budget it consumes */
+USTRUCT(BlueprintType)
+struct ENEMYCREATOR_API FEnemySpawnManifest
+{
+    GENERATED_BODY()
+    
+    /** Configurations to spawn, most numerous first */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Manifest")
+    TArray<FEnemySpawnManifestEntry> Entries;
+    
+    /** Total cost of the manifest; MemoryBytes counts each configuration once */
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Manifest")
+    FEnemyCostReport Total;
+    
+    /** Number of enemies in the manifest */
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Manifest")
+    int32 NumEnemies = 0;
+};
+
+/**
+ * Fills an encounter budget with enemy configurations
+ * Candidates come from the cost tags every configuration publishes to the asset registry, so no
+ * configuration or template is loaded. Solving is a multi-dimensional knapsack: a greedy fill by
+ * points per unit of budget, then single-instance swaps that raise the total, each followed by a refill.
+ */
+class ENEMYCREATOR_API FEnemyEncounterSolver
+{
+public:
+    /** One configuration as seen through its asset registry tags */
+    struct FCandidate
+    {
+        FSoftObjectPath Configuration;
+        FEnemyCostReport Cost;
+        FGameplayTagContainer Tags;
+    };
+    
+    /** Add every configuration in the asset registry. Returns the number of candidates added */
+    int32 GatherCandidates();
+    
+    /** Add a configuration from its asset data. Returns false when it carries no cost tags */
+    bool AddCandidate(const FAssetData& AssetData);
+    
+    /** Add a candidate directly */
+    void AddCandidate(FCandidate&& Candidate) { Candidates.Add(MoveTemp(Candidate)); }
+    
+    /** Candidates gathered so far */
+    const TArray<FCandidate>& GetCandidates() const { return Candidates; }
+    
+    /** Pick the configurations and counts that fill Budget with the most points */
+    FEnemySpawnManifest Solve(const FEnemyEncounterBudget& Budget) const;
+
+private:
+    TArray<FCandidate> Candidates;
+};
@@ -0,0 +1,108 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Misc/ScopeRWLock.h"
+#include "EnemyResolvedTemplate.h"
+
+/**
+ * Hash-consing table for one resolved facet type
+ * Holds weak references only, so a facet lives exactly as long as some snapshot or configuration uses it.
+ * Interning content equal to a live entry returns that entry, which makes pointer equality content equality.
+ */
+template <typename FacetType>
+class TEnemyFacetInternTable
+{
+public:
+    using FFacetRef = TSharedRef<const FacetType, ESPMode::ThreadSafe>;
+    using FFacetWeakPtr = TWeakPtr<const FacetType, ESPMode::ThreadSafe>;
+
+    /** Return the shared facet equal to Facet, adding it if no live entry matches */
+    FFacetRef Intern(FacetType&& Facet)
+    {
+        const uint32 Hash = GetTypeHash(Facet);
+
+        {
+            FReadScopeLock ReadLock(Lock);
+            if (TSharedPtr<const FacetType, ESPMode::ThreadSafe> Existing = FindLocked(Hash, Facet))
+            {
+                return Existing.ToSharedRef();
+            }
+        }
+
+        FWriteScopeLock WriteLock(Lock);
+
+        // Another thread may have added it between the locks
+        if (TSharedPtr<const FacetType, ESPMode::ThreadSafe> Existing = FindLocked(Hash, Facet))
+        {
+            return Existing.ToSharedRef();
+        }
+
+        // Reuse the bucket to drop entries that died since they were added
+        for (auto It = Entries.CreateKeyIterator(Hash); It; ++It)
+        {
+            if (!It.Value().IsValid())
+            {
+                It.RemoveCurrent();
+            }
+        }
+
+        FFacetRef NewFacet = MakeShared<FacetType, ESPMode::ThreadSafe>(MoveTemp(Facet));
+        Entries.Add(Hash, NewFacet);
+        return NewFacet;
+    }
+
+    /** Remove every entry whose facet is no longer referenced */
+    void Compact()
+    {
+        FWriteScopeLock WriteLock(Lock);
+        for (auto It = Entries.CreateIterator(); It; ++It)
+        {
+            if (!It.Value().IsValid())
+            {
+                It.RemoveCurrent();
+            }
+        }
+        Entries.Compact();
+    }
+
+    /** Number of entries, including ones not yet compacted */
+    int32 Num() const
+    {
+        FReadScopeLock ReadLock(Lock);
+        return Entries.Num();
+    }
+
+private:
+    TSharedPtr<const FacetType, ESPMode::ThreadSafe> FindLocked(uint32 Hash, const FacetType& Facet) const
+    {
+        for (auto It = Entries.CreateConstKeyIterator(Hash); It; ++It)
+        {
+            TSharedPtr<const FacetType, ESPMode::ThreadSafe> Candidate = It.Value().Pin();
+            if (Candidate.IsValid() && *Candidate == Facet)
+            {
+                return Candidate;
+            }
+        }
+        return nullptr;
+    }
+
+    mutable FRWLock Lock;
+    TMultiMap<uint32, FFacetWeakPtr> Entries;
+};
+
+/** Process-wide intern tables for resolved template facets */
+namespace EnemyFacetIntern
+{
+    ENEMYCREATOR_API FEnemyVisualsFacet Intern(FEnemyResolvedVisuals&& Visuals);
+    ENEMYCREATOR_API FEnemyAIConfigFacet Intern(FEnemyResolvedAIConfig&& AIConfig);
+    ENEMYCREATOR_API FEnemyAbilitiesFacet Intern(FEnemyAbilityTable&& Abilities);
+
+    /**
+     * Drop dead entries from every table
+     * Intern only prunes the bucket it inserts into, so this runs where many snapshots are released at once:
+     * when a world's registry shuts down and after a bulk edit republishes templates.
+     */
+    ENEMYCREATOR_API void Compact();
+}
@@ -0,0 +1,128 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Algo/BinarySearch.h"
+
+/** Key ordering used by TEnemyFlatMap. FName keys use the fast index order, which is stable for the lifetime of the process */
+template <typename KeyType>
+struct TEnemyFlatMapKeyLess : TLess<KeyType>
+{
+};
+
+template <>
+struct TEnemyFlatMapKeyLess<FName> : FNameFastLess
+{
+};
+
+/**
+ * Small sorted key/value array for runtime parameter sets
+ * Replaces TMap where sets hold a handful of entries: no hash buckets, entries stored inline up to
+ * the allocator's capacity, and iteration yields TPair like TMap so call sites read the same.
+ * Diff walks both maps once in key order.
+ */
+template <typename KeyType, typename ValueType, typename Allocator = TInlineAllocator<8>>
+class TEnemyFlatMap
+{
+public:
+    using ElementType = TPair<KeyType, ValueType>;
+    using KeyLess = TEnemyFlatMapKeyLess<KeyType>;
+
+    TEnemyFlatMap() = default;
+
+    /** Build from a TMap, sorting once */
+    template <typename MapAllocator>
+    static TEnemyFlatMap FromMap(const TMap<KeyType, ValueType, MapAllocator>& Map)
+    {
+        TEnemyFlatMap Result;
+        Result.Entries.Reserve(Map.Num());
+        for (const auto& Pair : Map)
+        {
+            Result.Entries.Emplace(Pair.Key, Pair.Value);
+        }
+        Result.Entries.Sort([](const ElementType& A, const ElementType& B) { return KeyLess()(A.Key, B.Key); });
+        return Result;
+    }
+
+    /** Build from unsorted pairs with unique keys, sorting once */
+    static TEnemyFlatMap FromPairs(TConstArrayView<ElementType> Pairs)
+    {
+        TEnemyFlatMap Result;
+        Result.Entries.Append(Pairs.GetData(), Pairs.Num());
+        Result.Entries.Sort([](const ElementType& A, const ElementType& B) { return KeyLess()(A.Key, B.Key); });
+        return Result;
+    }
+
+    /** Find a value by key */
+    const ValueType* Find(const KeyType& Key) const
+    {
+        const int32 Index = LowerBound(Key);
+        return Entries.IsValidIndex(Index) && !KeyLess()(Key, Entries[Index].Key) ? &Entries[Index].Value : nullptr;
+    }
+
+    /**
+     * Walk two maps in key order and report every key whose value differs
+     * Visitor receives (Key, const ValueType* Before, const ValueType* After); a null side means the key is absent there.
+     */
+    template <typename OtherAllocator, typename VisitorType>
+    static void Diff(const TEnemyFlatMap& Before, const TEnemyFlatMap<KeyType, ValueType, OtherAllocator>& After, VisitorType&& Visitor)
+    {
+        const TArray<ElementType, Allocator>& A = Before.Entries;
+        const TArray<ElementType, OtherAllocator>& B = After.GetEntries();
+        int32 Left = 0;
+        int32 Right = 0;
+        while (Left < A.Num() || Right < B.Num())
+        {
+            if (Right == B.Num() || (Left < A.Num() && KeyLess()(A[Left].Key, B[Right].Key)))
+            {
+                Visitor(A[Left].Key, &A[Left].Value, static_cast<const ValueType*>(nullptr));
+                ++Left;
+            }
+            else if (Left == A.Num() || KeyLess()(B[Right].Key, A[Left].Key))
+            {
+                Visitor(B[Right].Key, static_cast<const ValueType*>(nullptr), &B[Right].Value);
+                ++Right;
+            }
+            else
+            {
+                if (!(A[Left].Value == B[Right].Value))
+                {
+                    Visitor(A[Left].Key, &A[Left].Value, &B[Right].Value);
+                }
+                ++Left;
+                ++Right;
+            }
+        }
+    }
+
+    int32 Num() const { return Entries.Num(); }
+    bool IsEmpty() const { return Entries.Num() == 0; }
+    void Reset() { Entries.Reset(); }
+    const TArray<ElementType, Allocator>& GetEntries() const { return Entries; }
+
+    bool operator==(const TEnemyFlatMap& Other) const { return Entries == Other.Entries; }
+    bool operator!=(const TEnemyFlatMap& Other) const { return !(*this == Other); }
+
+    friend uint32 GetTypeHash(const TEnemyFlatMap& Map)
+    {
+        uint32 Hash = static_cast<uint32>(Map.Num());
+        for (const ElementType& Entry : Map.Entries)
+        {
+            Hash = HashCombineFast(Hash, HashCombineFast(GetTypeHash(Entry.Key), GetTypeHash(Entry.Value)));
+        }
+        return Hash;
+    }
+
+    auto begin() const { return Entries.begin(); }
+    auto end() const { return Entries.end(); }
+
+private:
+    /** First index whose key is not less than Key */
+    int32 LowerBound(const KeyType& Key) const
+    {
+        return Algo::LowerBound(Entries, Key, [](const ElementType& Entry, const KeyType& Value) { return KeyLess()(Entry.Key, Value); });
+    }
+
+    TArray<ElementType, Allocator> Entries;
+};
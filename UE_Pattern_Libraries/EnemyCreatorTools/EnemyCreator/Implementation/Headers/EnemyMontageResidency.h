@@ -0,0 +1,49 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class UAnimMontage;
+struct FEnemyAbilityTable;
+struct FStreamableHandle;
+
+/**
+ * Ability montages kept loaded because some enemy is about to need them
+ * Systems that can see an ability coming require its montage each time they look; the first request
+ * streams it in at high priority and the handle keeps it resident. A montage nobody has required for
+ * the eviction delay is released, so montages of idle enemies and finished boss phases can be collected.
+ */
+class ENEMYCREATOR_API FEnemyMontageResidency
+{
+public:
+    /** Keep a montage resident as of Now, requesting it if it is not already */
+    void Require(const TSoftObjectPtr<UAnimMontage>& Montage, double Now);
+    
+    /** Require the montage of every ability in a table */
+    void RequireAbilities(const FEnemyAbilityTable& Abilities, double Now);
+    
+    /** Release every montage last required more than Linger seconds before Now. Returns the number released */
+    int32 Evict(double Now, double Linger);
+    
+    /** Whether a montage is tracked and finished loading */
+    bool IsResident(const TSoftObjectPtr<UAnimMontage>& Montage) const;
+    
+    /** Release every montage */
+    void Reset();
+    
+    /** Number of tracked montages, loaded or loading */
+    int32 Num() const { return Montages.Num(); }
+
+private:
+    struct FResidentMontage
+    {
+        /** Keeps the montage loaded while held */
+        TSharedPtr<FStreamableHandle> Handle;
+        
+        /** World time of the latest Require */
+        double LastRequiredTime = 0.0;
+    };
+    
+    TMap<FSoftObjectPath, FResidentMontage> Montages;
+};
@@ -0,0 +1,59 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "EnemyResolvedTemplate.h"
+
+class ACharacter;
+class UEnemyTemplate;
+
+/**
+ * Runtime phase state for one boss
+ * Walks the snapshot's precomputed phases forward on health and time thresholds. A transition hands
+ * back the next phase's snapshot; nothing is resolved while the fight is running.
+ */
+class ENEMYCREATOR_API FEnemyPhaseMachine
+{
+public:
+    FEnemyPhaseMachine(ACharacter* InEnemy, const UEnemyTemplate& InTemplate, const FEnemyResolvedTemplateRef& InOpeningSnapshot);
+    
+    /**
+     * Advance the phase timer and check the next phase's thresholds, entering as many phases as are due
+     * @param HealthFraction   Current health over maximum health
+     * @return Whether the phase changed
+     */
+    bool Update(float DeltaTime, float HealthFraction);
+    
+    /** Snapshot of the current phase */
+    const FEnemyResolvedTemplateRef& GetActiveSnapshot() const;
+    
+    /** Index into the opening snapshot's Phases, INDEX_NONE during the opening phase */
+    int32 GetPhaseIndex() const { return PhaseIndex; }
+    
+    /** Whether every phase has been entered */
+    bool IsInFinalPhase() const { return PhaseIndex == OpeningSnapshot->Phases.Num() - 1; }
+    
+    /** Phase entered next, null in the final phase */
+    const FEnemyResolvedPhase* GetNextPhase() const;
+    
+    /**
+     * Whether the next phase is close to triggering
+     * @param HealthMargin   Health fraction above the next phase's threshold that counts as close
+     * @param TimeMargin     Seconds before the next phase's time trigger that count as close
+     */
+    bool IsNextPhaseNear(float HealthFraction, float HealthMargin, float TimeMargin) const;
+    
+    /** The boss this machine drives */
+    TWeakObjectPtr<ACharacter> Enemy;
+    
+    /** Template the boss was applied from */
+    TWeakObjectPtr<const UEnemyTemplate> Template;
+    
+private:
+    /** Snapshot the boss was spawned with; owns the resolved phases */
+    FEnemyResolvedTemplateRef OpeningSnapshot;
+    
+    int32 PhaseIndex = INDEX_NONE;
+    float TimeInPhase = 0.0f;
+};
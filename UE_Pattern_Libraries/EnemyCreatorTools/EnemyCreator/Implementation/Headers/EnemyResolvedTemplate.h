@@ -0,0 +1,180 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameplayTagContainer.h"
+#include "EnemyTemplateTypes.h"
+#include "EnemyAbilityTable.h"
+#include "EnemyFlatMap.h"
+#include "EnemyTraitMask.h"
+
+class UEnemyTemplate;
+struct FEnemyResolvedTemplate;
+
+/** Shared, immutable snapshot handles. Safe to copy and read from any thread */
+using FEnemyResolvedTemplateRef = TSharedRef<const FEnemyResolvedTemplate, ESPMode::ThreadSafe>;
+using FEnemyResolvedTemplatePtr = TSharedPtr<const FEnemyResolvedTemplate, ESPMode::ThreadSafe>;
+
+/**
+ * Runtime form of FEnemyVisualCustomization
+ * Parameter sets are sorted flat arrays with inline storage instead of TMaps.
+ */
+struct ENEMYCREATOR_API FEnemyResolvedVisuals
+{
+    /** Convert from the authored representation */
+    static FEnemyResolvedVisuals FromCustomization(const FEnemyVisualCustomization& Customization);
+
+    TSoftObjectPtr<USkeletalMesh> SkeletalMesh;
+    TSoftObjectPtr<UAnimBlueprint> AnimationBlueprint;
+    FVector Scale = FVector(1.0f);
+    FLinearColor ColorTint = FLinearColor::White;
+    TEnemyFlatMap<FName, float> ScalarParameters;
+    TEnemyFlatMap<FName, FLinearColor, TInlineAllocator<4>> VectorParameters;
+    TEnemyFlatMap<FName, TSoftObjectPtr<UTexture>, TInlineAllocator<2>> TextureParameters;
+    TEnemyFlatMap<int32, TSoftObjectPtr<UMaterialInterface>, TInlineAllocator<2>> MaterialOverrides;
+    TArray<FEnemyVisualLODTier, TInlineAllocator<2>> LODTiers;
+
+    bool operator==(const FEnemyResolvedVisuals& Other) const;
+    bool operator!=(const FEnemyResolvedVisuals& Other) const { return !(*this == Other); }
+    friend ENEMYCREATOR_API uint32 GetTypeHash(const FEnemyResolvedVisuals& Visuals);
+
+    /**
+     * Hash of everything that changes how these visuals look in a still preview
+     * Built from asset paths and names as text rather than FName indices, so it is stable across sessions
+     * and can key caches on disk. Leaves out the animation blueprint and LOD tiers, which a reference pose
+     * at full quality never shows.
+     */
+    uint64 GetContentHash() const;
+};
+
+/**
+ * Runtime form of FEnemyAIConfig
+ * Behavior parameters are a sorted flat array instead of a TMap.
+ */
+struct ENEMYCREATOR_API FEnemyResolvedAIConfig
+{
+    /** Convert from the authored representation */
+    static FEnemyResolvedAIConfig FromConfig(const FEnemyAIConfig& Config);
+
+    TSoftObjectPtr<UBehaviorTree> BehaviorTree;
+    TSoftObjectPtr<UBlackboardData> Blackboard;
+    float AggressionLevel = 0.5f;
+    float PreferredRange = 300.0f;
+    bool bUseCover = false;
+    bool bCoordinateWithAllies = false;
+    TEnemyFlatMap<FName, float> BehaviorParameters;
+    FGameplayTagContainer PersonalityTags;
+
+    bool operator==(const FEnemyResolvedAIConfig& Other) const;
+    bool operator!=(const FEnemyResolvedAIConfig& Other) const { return !(*this == Other); }
+    friend ENEMYCREATOR_API uint32 GetTypeHash(const FEnemyResolvedAIConfig& AIConfig);
+};
+
+/**
+ * Interned facet handles, see EnemyFacetIntern.h
+ * Facets with equal content share one allocation, so comparing handles compares content.
+ */
+using FEnemyVisualsFacet = TSharedRef<const FEnemyResolvedVisuals, ESPMode::ThreadSafe>;
+using FEnemyAIConfigFacet = TSharedRef<const FEnemyResolvedAIConfig, ESPMode::ThreadSafe>;
+using FEnemyAbilitiesFacet = TSharedRef<const FEnemyAbilityTable, ESPMode::ThreadSafe>;
+
+/** Authored phase list shared by a snapshot and everything derived from it */
+using FEnemyPhaseDefinitionsPtr = TSharedPtr<const TArray<FEnemyPhaseDefinition>, ESPMode::ThreadSafe>;
+
+/** A boss phase resolved against the snapshot that owns it */
+struct FEnemyResolvedPhase
+{
+    FName PhaseName;
+    float HealthThreshold = 0.0f;
+    float TimeInPreviousPhase = 0.0f;
+
+    /** Snapshot to swap to on entering the phase. Shares every facet the phase does not change */
+    FEnemyResolvedTemplateRef Snapshot;
+};
+
+/**
+ * Fully resolved enemy template data
+ * Built on the game thread from a template and its inheritance chain, then never modified.
+ * Edits publish a new snapshot instead of mutating this one, so readers holding a reference
+ * always see a consistent set of stats, abilities and AI config.
+ */
+struct ENEMYCREATOR_API FEnemyResolvedTemplate
+{
+    FEnemyResolvedTemplate(FEnemyVisualsFacet InVisuals, FEnemyAIConfigFacet InAIConfig, FEnemyAbilitiesFacet InAbilities)
+        : AIConfig(MoveTemp(InAIConfig))
+        , Visuals(MoveTemp(InVisuals))
+        , Abilities(MoveTemp(InAbilities))
+    {
+    }
+
+    /** Resolve a template and its parents into a new snapshot. Game thread only */
+    static FEnemyResolvedTemplateRef Build(const UEnemyTemplate& Template);
+
+    /**
+     * Derive a snapshot with configuration modifications applied. Game thread only
+     * Returns Base itself when the modification changes nothing; blocks that are not overridden stay shared with Base.
+     */
+    static FEnemyResolvedTemplateRef BuildVariant(const FEnemyResolvedTemplateRef& Base, const FEnemyTemplateModification& Modification);
+
+    /** Take the next snapshot serial */
+    static uint32 AllocateSerial();
+
+    /** Compute the trait mask for a resolved block combination */
+    static FEnemyTraitMask BuildTraitMask(EEnemyType Type, const FEnemyResolvedAIConfig& AIConfig, const FEnemyAbilityTable& Abilities, const FGameplayTagContainer& Tags);
+
+    /** Name of the template this snapshot was built from */
+    FName TemplateName;
+
+    /** Template names from this template up to the root */
+    TArray<FName> InheritanceChain;
+
+    /** Monotonic publish counter, unique per snapshot */
+    uint32 Serial = 0;
+
+    /** Enemy archetype */
+    EEnemyType EnemyType = EEnemyType::Melee;
+
+    /** Archetype, AI flags and mapped tags packed for runtime filtering */
+    FEnemyTraitMask TraitMask;
+
+    /** Resolved stat block at the default difficulty tier */
+    FEnemyBaseStats BaseStats;
+
+    /** Stat block for every difficulty tier, indexed by tier, so a tier switch never evaluates scaling */
+    TArray<FEnemyBaseStats, TInlineAllocator<4>> TierStats;
+
+    /**
+     * Stats for a difficulty tier
+     * Tables are sized by the tier count configured when the snapshot was built. A tier outside them, such as
+     * after DifficultyTiers was edited, returns the default tier's stats and warns once.
+     */
+    const FEnemyBaseStats& GetTierStats(int32 Tier) const;
+
+    /** Fill TierStats from BaseStats and the difficulty multipliers. Called once while the snapshot is built */
+    void BuildTierStats();
+
+    /** Resolved scaling configuration */
+    FEnemyStatScaling StatScaling;
+
+    /** Resolved AI configuration, shared with every snapshot that resolves to the same block */
+    FEnemyAIConfigFacet AIConfig;
+
+    /** Resolved visual configuration, shared with every snapshot that resolves to the same block */
+    FEnemyVisualsFacet Visuals;
+
+    /** Abilities merged across the inheritance chain, children overriding parents by name. Shared like the other facets */
+    FEnemyAbilitiesFacet Abilities;
+
+    /** Template tags */
+    FGameplayTagContainer TemplateTags;
+
+    /** Authored phases, kept so derived snapshots resolve the same phases against their own blocks. Null without phases */
+    FEnemyPhaseDefinitionsPtr PhaseDefinitions;
+
+    /** Phases after the opening one, in order */
+    TArray<FEnemyResolvedPhase> Phases;
+
+    /** Resolve phase definitions against this snapshot's final blocks. Called once, last, while the snapshot is built */
+    void BuildPhases(FEnemyPhaseDefinitionsPtr Definitions);
+};
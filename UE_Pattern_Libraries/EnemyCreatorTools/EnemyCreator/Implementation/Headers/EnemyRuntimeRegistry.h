@@ -0,0 +1,214 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "EnemyResolvedTemplate.h"
+#include "EnemyTraitMask.h"
+#include "EnemyEffectSpecPool.h"
+#include "EnemyEliteComposer.h"
+#include "EnemyPhaseMachine.h"
+#include "EnemySpatialHash.h"
+#include "EnemyMontageResidency.h"
+#include "EnemyRuntimeRegistry.generated.h"
+
+class ACharacter;
+class UAbilitySystemComponent;
+class UGameplayEffect;
+
+/** Called when a registered enemy's stats are replaced in place, such as on a difficulty tier switch */
+DECLARE_MULTICAST_DELEGATE_TwoParams(FOnEnemyStatsChanged, ACharacter* /*Enemy*/, const FEnemyBaseStats& /*Stats*/);
+
+/**
+ * World-level registry of live template-spawned enemies
+ * Per-enemy runtime data is kept in parallel contiguous arrays indexed by a dense slot, so
+ * world-wide queries scan plain arrays instead of visiting actors. Removal swaps with the last slot.
+ */
+UCLASS()
+class ENEMYCREATOR_API UEnemyRuntimeRegistry : public UTickableWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    //~ Begin UObject Interface
+    static void AddReferencedObjects(UObject* InThis, FReferenceCollector& Collector);
+    //~ End UObject Interface
+    
+    //~ Begin USubsystem Interface
+    virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+    virtual void Deinitialize() override;
+    //~ End USubsystem Interface
+    
+    //~ Begin FTickableGameObject Interface
+    virtual void Tick(float DeltaTime) override;
+    virtual TStatId GetStatId() const override;
+    //~ End FTickableGameObject Interface
+    
+    //~ Begin Registration
+    /** Register an enemy, or refresh its data if already registered, notifying OnStatsChanged if its stats differ */
+    void RegisterEnemy(ACharacter* Enemy, const FEnemyResolvedTemplateRef& Template);
+    
+    /** Remove an enemy */
+    void UnregisterEnemy(ACharacter* Enemy);
+    
+    /** Start driving an enemy's phases from its opening snapshot, replacing any running machine. No-op without phases */
+    void StartPhaseMachine(ACharacter* Enemy, const UEnemyTemplate& Template, const FEnemyResolvedTemplateRef& OpeningSnapshot);
+    
+    /** Number of registered enemies */
+    int32 Num() const { return Actors.Num(); }
+    //~ End Registration
+    
+    //~ Begin Queries
+    /** Every registered enemy whose traits match */
+    void QueryByTraits(FEnemyTraitMask Required, FEnemyTraitMask Excluded, TArray<ACharacter*>& OutEnemies) const;
+    
+    /** Every registered enemy whose traits match within Radius of Center */
+    void QueryByTraitsInRadius(const FVector& Center, float Radius, FEnemyTraitMask Required, FEnemyTraitMask Excluded, TArray<ACharacter*>& OutEnemies) const;
+    
+    /**
+     * For every enemy whose abilities include AbilityName, the matching enemies within that ability's range
+     * Each source uses the range from its own resolved template and is never its own neighbor.
+     */
+    void QueryAbilityRange(FName AbilityName, FEnemyTraitMask Required, FEnemyTraitMask Excluded, FEnemyRangeQueryResult& OutResult) const;
+    
+    /** For every enemy whose traits match SourceRequired, the matching enemies within its preferred AI range */
+    void QueryPreferredRange(FEnemyTraitMask SourceRequired, FEnemyTraitMask Required, FEnemyTraitMask Excluded, FEnemyRangeQueryResult& OutResult) const;
+    
+    /** Enemy in a slot returned by a range query */
+    ACharacter* GetEnemyAtSlot(int32 Slot) const { return Actors.IsValidIndex(Slot) ? Actors[Slot].Get() : nullptr; }
+    
+    /**
+     * Current stats of a registered enemy at the active difficulty tier, null if not registered
+     * This is the source of truth for tiered stats; nothing is written to the enemy's attributes. Systems that
+     * copy stats elsewhere, such as into an attribute set, should bind OnStatsChanged to stay in step.
+     */
+    const FEnemyBaseStats* FindStats(ACharacter* Enemy) const;
+    
+    /** Current resolved template of a registered enemy, null if not registered */
+    FEnemyResolvedTemplatePtr FindTemplate(ACharacter* Enemy) const;
+    
+    /**
+     * Pick a registered enemy's next ability from its current resolved abilities, see FEnemyAbilityTable::SelectAbilityInRange
+     * AI should decide through here so the decision is captured while a spawn replay is recording.
+     * @return Record index into the enemy's abilities, or INDEX_NONE
+     */
+    int32 SelectAbility(ACharacter* Enemy, float Distance, TArrayView<const float> CooldownRemaining, float AvailableResource) const;
+    //~ End Queries
+    
+    /** Broadcast per enemy after its stats changed in place: on a difficulty switch, or when it is registered again with different stats */
+    FOnEnemyStatsChanged& OnStatsChanged() { return StatsChanged; }
+    
+    /** Effect specs shared by every enemy in this world */
+    FEnemyEffectSpecPool& GetEffectSpecPool() { return EffectSpecPool; }
+    
+    /** Elite affix compositions shared by every spawn in this world */
+    FEnemyEliteComposer& GetEliteComposer() { return EliteComposer; }
+    
+    /** Ability montages kept loaded for enemies about to use them */
+    FEnemyMontageResidency& GetMontageResidency() { return MontageResidency; }
+    
+protected:
+    //~ Begin UWorldSubsystem Interface
+    virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+    //~ End UWorldSubsystem Interface
+    
+    /** Remove the enemy in a dense slot by swapping the last slot into it */
+    void RemoveAtSlot(int32 Slot);
+    
+    /** Rescale every live enemy to a new difficulty tier in one pass over the stat array, then notify OnStatsChanged per enemy */
+    void HandleDifficultyTierChanged(int32 NewTier);
+    
+    /** Advance every phase machine and apply the transitions that fire, prefetching montages of phases about to start */
+    void TickPhaseMachines(float DeltaTime);
+    
+    /**
+     * Keep montages resident for abilities about to be used
+     * An ability counts once its cooldown is nearly over and the enemy's focus target is nearly in its
+     * range. Montages nothing has needed for the eviction delay are released.
+     */
+    void TickMontageResidency(float DeltaTime);
+    
+    /**
+     * Pulse every aura in one pass
+     * Sources are gathered by trait mask and their auras summed per recipient into flat arrays before
+     * any ability system is touched. Each recipient then gets one combined heal, and its buff effect is
+     * replaced only when the combined buff changed since the last pulse. Heal auras wait out their ability's
+     * CooldownTime between heals; buff auras hold for as long as the recipient stays in range.
+     */
+    void TickAuras(float DeltaTime);
+    
+    /** Append one source's matching neighbors to a batched result */
+    void AppendNeighbors(int32 SourceSlot, float Radius, FEnemyTraitMask Required, FEnemyTraitMask Excluded, FEnemyRangeQueryResult& OutResult) const;
+    
+    /** Live enemy actors */
+    TArray<TWeakObjectPtr<ACharacter>> Actors;
+    
+    /** Resolved template each enemy was applied from */
+    TArray<FEnemyResolvedTemplatePtr> Templates;
+    
+    /** Trait mask bits per enemy */
+    TArray<uint64> TraitMasks;
+    
+    /** World locations per enemy, refreshed each tick */
+    TArray<FVector> Locations;
+    
+    /** Stats per enemy at the active difficulty tier, copied from the template's precomputed tier table */
+    TArray<FEnemyBaseStats> Stats;
+    
+    /** Ability system per enemy, looked up once at registration */
+    TArray<TWeakObjectPtr<UAbilitySystemComponent>> AbilitySystems;
+    
+    /** Aura buff currently applied to an enemy, and the cooldowns of the heal auras it emits */
+    struct FAuraState
+    {
+        float BuffMagnitude = 0.0f;
+        FActiveGameplayEffectHandle BuffHandle;
+        
+        /** Seconds until each of the enemy's aura records may heal again, in record order. Cleared when its template changes */
+        TArray<float, TInlineAllocator<4>> HealCooldowns;
+    };
+    
+    /** Aura state per enemy */
+    TArray<FAuraState> AuraStates;
+    
+    /** Grid over Locations, updated as enemies cross cells */
+    FEnemySpatialHash SpatialHash;
+    
+    /** Dense slot lookup. Weak keys still hash and compare after the actor is gone */
+    TMap<TWeakObjectPtr<ACharacter>, int32> SlotByActor;
+    
+    /** Shared effect specs for template effects */
+    FEnemyEffectSpecPool EffectSpecPool;
+    
+    /** Memoized elite affix compositions */
+    FEnemyEliteComposer EliteComposer;
+    
+    /** Running boss phase machines. Few enough that they live outside the per-slot arrays */
+    TArray<FEnemyPhaseMachine> PhaseMachines;
+    
+    /** Montages resident for upcoming abilities */
+    FEnemyMontageResidency MontageResidency;
+    
+    /** Aura effects resolved from settings at initialization */
+    UPROPERTY()
+    TSubclassOf<UGameplayEffect> HealAuraEffect;
+    
+    UPROPERTY()
+    TSubclassOf<UGameplayEffect> BuffAuraEffect;
+    
+    /** Time since the last aura pulse */
+    float AuraPulseTime = 0.0f;
+    
+    /** Time since the last montage residency pass */
+    float MontageResidencyTime = 0.0f;
+    
+    /** Difficulty switch subscription */
+    FDelegateHandle DifficultyChangedHandle;
+    
+    /** Affix edit subscription, drops stale elite compositions */
+    FDelegateHandle AffixChangedHandle;
+    
+    /** Per-enemy stat change listeners */
+    FOnEnemyStatsChanged StatsChanged;
+};
@@ -0,0 +1,122 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Neighbors found by a batched range query, flattened into one buffer
+ * Slot indices refer to the runtime registry and stay valid until its next registration change.
+ */
+struct FEnemyRangeQueryResult
+{
+    /** Querying slots */
+    TArray<int32> Sources;
+    
+    /** Neighbors of Sources[i] occupy Neighbors[Offsets[i]] up to Neighbors[Offsets[i + 1]] */
+    TArray<int32> Offsets;
+    
+    /** Neighbor slots of every source, back to back */
+    TArray<int32> Neighbors;
+    
+    /** Neighbors of one source */
+    TConstArrayView<int32> GetNeighbors(int32 SourceIndex) const
+    {
+        return TConstArrayView<int32>(Neighbors.GetData() + Offsets[SourceIndex], Offsets[SourceIndex + 1] - Offsets[SourceIndex]);
+    }
+    
+    void Reset()
+    {
+        Sources.Reset();
+        Offsets.Reset();
+        Neighbors.Reset();
+    }
+};
+
+/**
+ * Uniform grid over the XY plane indexing the runtime registry's dense slots
+ * Each slot remembers its cell, so a location update only touches the grid when the enemy crosses
+ * a cell edge. Queries visit the cells overlapping the query circle and test the registry's
+ * location array directly, which keeps clustered packs to a handful of cell walks per query.
+ */
+class ENEMYCREATOR_API FEnemySpatialHash
+{
+public:
+    explicit FEnemySpatialHash(float InCellSize = 600.0f);
+    
+    /** Change the cell edge length, rebuilding the grid from the slot locations */
+    void SetCellSize(float InCellSize, TConstArrayView<FVector> Locations);
+    
+    /** Index a new slot. Slots must be added in order, matching the registry's arrays */
+    void Add(int32 Slot, const FVector& Location);
+    
+    /** Move a slot to its new location's cell. Cheap when the cell is unchanged */
+    void Update(int32 Slot, const FVector& Location);
+    
+    /** Remove a slot the way the registry does: the last slot is renumbered into its place */
+    void RemoveAtSwap(int32 Slot);
+    
+    /** Drop every slot */
+    void Reset();
+    
+    /** Call Visitor(Slot) for every slot within Radius of Center */
+    template <typename VisitorType>
+    void ForEachInRadius(const FVector& Center, float Radius, TConstArrayView<FVector> Locations, VisitorType&& Visitor) const
+    {
+        const FIntPoint MinCell = GetCell(Center - FVector(Radius, Radius, 0.0));
+        const FIntPoint MaxCell = GetCell(Center + FVector(Radius, Radius, 0.0));
+        const double RadiusSquared = FMath::Square(static_cast<double>(Radius));
+        
+        for (int32 CellY = MinCell.Y; CellY <= MaxCell.Y; ++CellY)
+        {
+            for (int32 CellX = MinCell.X; CellX <= MaxCell.X; ++CellX)
+            {
+                const FCellSlots* CellSlots = Cells.Find(FIntPoint(CellX, CellY));
+                if (!CellSlots)
+                {
+                    continue;
+                }
+                
+                for (const int32 Slot : *CellSlots)
+                {
+                    if (FVector::DistSquared(Locations[Slot], Center) <= RadiusSquared)
+                    {
+                        Visitor(Slot);
+                    }
+                }
+            }
+        }
+    }
+    
+    /** Number of indexed slots */
+    int32 Num() const { return SlotCells.Num(); }
+    
+    /** Number of occupied cells */
+    int32 NumCells() const { return Cells.Num(); }
+
+private:
+    using FCellSlots = TArray<int32, TInlineAllocator<8>>;
+    
+    FIntPoint GetCell(const FVector& Location) const
+    {
+        return FIntPoint(FMath::FloorToInt32(Location.X * InvCellSize), FMath::FloorToInt32(Location.Y * InvCellSize));
+    }
+    
+    /** Insert a slot into a cell's list and remember where it went */
+    void LinkSlot(int32 Slot, const FIntPoint& Cell);
+    
+    /** Take a slot out of its cell's list, dropping the cell once empty */
+    void UnlinkSlot(int32 Slot);
+    
+    float CellSize;
+    float InvCellSize;
+    
+    /** Slots per occupied cell */
+    TMap<FIntPoint, FCellSlots> Cells;
+    
+    /** Cell each slot is in, indexed by slot */
+    TArray<FIntPoint> SlotCells;
+    
+    /** Position of each slot within its cell's list, indexed by slot */
+    TArray<int32> SlotIndexInCell;
+};
@@ -0,0 +1,108 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class UEnemyConfiguration;
+
+/** Kind of each record in a spawn replay log */
+enum class EEnemyReplayRecordType : uint8
+{
+    /** World time advanced by DeltaTime */
+    Frame,
+    
+    /** A configuration was applied to a newly spawned enemy */
+    Spawn,
+    
+    /** An enemy picked its next ability */
+    AbilityDecision,
+    
+    /** Last record of a log */
+    End
+};
+
+/** One record of a spawn replay log. Only the members for its type are meaningful */
+struct ENEMYCREATOR_API FEnemyReplayRecord
+{
+    EEnemyReplayRecordType Type = EEnemyReplayRecordType::End;
+    
+    /** Frame: seconds of world time */
+    float DeltaTime = 0.0f;
+    
+    /** Spawn: configuration applied and actor class spawned */
+    FSoftObjectPath Configuration;
+    FSoftObjectPath EnemyClass;
+    
+    /** Spawn: where the enemy stood when configured */
+    FVector3f Location = FVector3f::ZeroVector;
+    float Yaw = 0.0f;
+    
+    /** Spawn: random seed in effect when the configuration was applied */
+    int32 Seed = 0;
+    
+    /** Spawn and AbilityDecision: session-unique enemy id, assigned in spawn order */
+    int32 EnemyId = INDEX_NONE;
+    
+    /** AbilityDecision: inputs to FEnemyAbilityTable::SelectAbilityInRange and the record index it returned */
+    float Distance = 0.0f;
+    float AvailableResource = 0.0f;
+    TArray<float, TInlineAllocator<8>> CooldownRemaining;
+    int32 SelectedAbility = INDEX_NONE;
+};
+
+/**
+ * Reads a spawn replay log back one record at a time
+ * The whole file is loaded up front so replay timing never includes disk reads.
+ */
+class ENEMYCREATOR_API FEnemySpawnReplayReader
+{
+public:
+    FEnemySpawnReplayReader();
+    ~FEnemySpawnReplayReader();
+    
+    /** Load a log. Returns false if the file is missing or was written by another log version */
+    bool Open(const FString& Filename);
+    
+    /** Read the next record. Returns false at the end of the log */
+    bool Next(FEnemyReplayRecord& OutRecord);
+
+private:
+    TArray<uint8> Bytes;
+    TUniquePtr<FArchive> Reader;
+    
+    /** Object paths seen so far, indexed as the log references them */
+    TArray<FSoftObjectPath> Paths;
+};
+
+/**
+ * Session recorder for enemy spawns and AI decisions
+ * Captures every configuration application with its spawn transform and random seed, every ability
+ * decision with its inputs, and the frame deltas between them, in a compact binary log. Replaying the
+ * log with the EnemySpawnReplay commandlet under -nullrhi reproduces the same enemy compositions and
+ * decisions without the rest of the game, so a playtest hitch can be profiled on a workstation.
+ * Start from the console or the command line with -ExecCmds="Enemy.Replay.Record <Name>".
+ */
+namespace EnemySpawnReplay
+{
+    /** Start recording, replacing any recording in progress. Game thread only */
+    ENEMYCREATOR_API void StartRecording(const FString& Filename);
+    
+    /** Finish the recording in progress and write it out. Returns false if nothing was recording or the write failed */
+    ENEMYCREATOR_API bool StopRecording();
+    
+    /** Whether a recording is in progress */
+    ENEMYCREATOR_API bool IsRecording();
+    
+    /** Default log location for a recording name */
+    ENEMYCREATOR_API FString GetReplayFilename(const FString& Name);
+    
+    /** Record world time advancing. Called once per frame by the runtime registry */
+    ENEMYCREATOR_API void RecordFrame(float DeltaTime);
+    
+    /** Record a configuration about to be applied to an enemy */
+    ENEMYCREATOR_API void RecordSpawn(const UEnemyConfiguration& Configuration, const AActor& Enemy);
+    
+    /** Record an ability decision and its inputs */
+    ENEMYCREATOR_API void RecordAbilityDecision(const AActor& Enemy, float Distance, TArrayView<const float> CooldownRemaining, float AvailableResource, int32 SelectedAbility);
+}
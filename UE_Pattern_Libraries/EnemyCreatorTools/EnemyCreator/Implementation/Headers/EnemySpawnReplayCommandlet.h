@@ -0,0 +1,28 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "EnemySpawnReplayCommandlet.generated.h"
+
+/**
+ * Replays a recorded enemy spawn log in an empty game world
+ * Spawns and configures every recorded enemy with its recorded seed, re-runs every ability decision
+ * against the enemy's resolved abilities, and ticks the world by the recorded frame deltas. Reports
+ * per-frame and per-spawn timings plus any decision that came out differently from the recording.
+ *
+ * Usage: UnrealEditor-Cmd <Project> -run=EnemySpawnReplay -Replay=<File> [-Loops=N] -nullrhi -unattended
+ */
+UCLASS()
+class ENEMYCREATOR_API UEnemySpawnReplayCommandlet : public UCommandlet
+{
+    GENERATED_BODY()
+
+public:
+    UEnemySpawnReplayCommandlet();
+    
+    //~ Begin UCommandlet Interface
+    virtual int32 Main(const FString& Params) override;
+    //~ End UCommandlet Interface
+};
@@ -6,8 +6,34 @@
 #include "Engine/DataAsset.h"
 #include "GameplayTags.h"
 #include "EnemyTemplateTypes.h"
+#include "EnemyResolvedTemplate.h"
+#include "EnemyAbilityView.h"
+#include "EnemyCreatorScratch.h"
 #include "EnemyTemplate.generated.h"
 
+namespace EnemyTemplate
+{
+    /** Apply path specialized for one archetype, selected through the type dispatch table */
+    template <EEnemyType Type>
+    struct TApplyResolved;
+}
+
+/**
+ * Asset registry tags published by every enemy template, enough to list and filter templates without loading them
+ * NumAbilities and VisualHash include inherited data, so they are stale for a child saved before its parent
+ * changed. Editing a parent dirties its loaded descendants whose tags changed; unloaded ones are re-tagged
+ * the next time they are saved.
+ */
+namespace EnemyTemplateTags
+{
+    extern ENEMYCREATOR_API const FName DisplayName;
+    extern ENEMYCREATOR_API const FName EnemyType;
+    extern ENEMYCREATOR_API const FName ParentTemplate;
+    extern ENEMYCREATOR_API const FName GameplayTags;
+    extern ENEMYCREATOR_API const FName NumAbilities;
+    extern ENEMYCREATOR_API const FName VisualHash;
+}
+
 /**
  * Data asset for defining enemy templates
  * Supports inheritance, configuration, and validation
@@ -21,39 +47,97 @@ public:
     UEnemyTemplate();
     
     //~ Begin UObject Interface
+    virtual void Serialize(FArchive& Ar) override;
     virtual void PostLoad() override;
+    virtual void BeginDestroy() override;
+    virtual void GetAssetRegistryTags(TArray<FAssetRegistryTag>& OutTags) const override;
     virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+    virtual void PostEditUndo() override;
     //~ End UObject Interface
     
     //~ Begin Template Interface
     /** Validate this template and all its dependencies */
-    virtual bool ValidateTemplate(FString& OutError);
+    virtual bool ValidateTemplate(FEnemyTemplateValidationResult& OutResult) const;
     
-    /** Apply this template to an enemy instance */
-    virtual void ApplyToEnemy(class ABaseEnemy* Enemy);
+    /** Validate a set of templates in one pass, validating shared parents once. Returns the number of invalid templates */
+    static int32 ValidateTemplates(TArrayView<const UEnemyTemplate* const> Templates, TArray<FEnemyTemplateValidationResult>& OutResults);
     
-    /** Create a new template inheriting from this one */
-    virtual UEnemyTemplate* CreateChildTemplate(const FString& ChildName);
+    /** Apply this template to an enemy instance, with optional configuration modifications */
+    virtual bool ApplyToInstance(class ACharacter* EnemyInstance, const FEnemyTemplateModification* Modification = nullptr) const;
     
-    /** Get the full inheritance chain for this template */
+    /** Apply an already resolved snapshot or configuration variant of this template to an enemy instance. Dispatches once on the archetype */
+    virtual bool ApplyResolved(class ACharacter* EnemyInstance, const FEnemyResolvedTemplateRef& Resolved) const;
+    
+    /** Move an instance from one snapshot of this template to another, applying only the facets that differ */
+    void ApplyTransition(class ACharacter* EnemyInstance, const FEnemyResolvedTemplate& From, const FEnemyResolvedTemplate& To) const;
+    
+    /** Create a new template inheriting from this one. The child references this template's blocks rather than copying them */
+    virtual UEnemyTemplate* CreateChildTemplate(const FName& NewTemplateName);
+    
+    /** Get the full inheritance chain for this template. Walks the chain on every call, nothing is cached */
     virtual TArray<UEnemyTemplate*> GetInheritanceChain() const;
+    
+    /** Get the loaded templates that name this one as their parent. Read from an index kept by load, edit and destruction. Game thread only */
+    void GetLoadedChildren(TArray<UEnemyTemplate*>& OutChildren) const;
+    
+    /** Get every loaded template inheriting from this one, directly or not, parents before their children. Game thread only */
+    void GetLoadedDescendants(TArray<UEnemyTemplate*>& OutDescendants) const;
+    
+    /** Get the current resolved snapshot. Safe to call from any thread; null until first published */
+    FEnemyResolvedTemplatePtr GetResolvedTemplate() const;
+    
+    /** Rebuild the resolved snapshot and swap it in. Game thread only */
+    void PublishResolvedTemplate();
     //~ End Template Interface
     
     //~ Begin Property Accessors
+    /** Map a stat name to its field in a stat block, null for unknown names */
+    static float* GetStatValuePtr(FEnemyBaseStats& Stats, FName StatName);
+    
     /** Get the template's unique name */
     FName GetTemplateName() const { return TemplateName; }
     
     /** Get the template's display name */
     FText GetDisplayName() const { return DisplayName; }
     
-    /** Get the parent template if any */
+    /** Get the enemy archetype */
+    EEnemyType GetEnemyType() const { return EnemyType; }
+    
+    /** Get the parent template if any. Loaded with this template through ParentTemplateReference; never loads anything itself */
     UEnemyTemplate* GetParentTemplate() const;
     
-    /** Get the base stats for this template */
-    const FEnemyBaseStats& GetBaseStats() const { return BaseStats; }
+    /** Get the base stats for this template, inherited from the nearest ancestor that defines them */
+    const FEnemyBaseStats& GetBaseStats() const;
     
-    /** Get the abilities defined in this template */
+    /** Get the abilities this template adds or replaces, excluding inherited ones */
     const TArray<FEnemyAbilityDefinition>& GetAbilities() const { return Abilities; }
+    
+    /** Get every ability including inherited ones, without copying any definition */
+    FEnemyAbilityView GetAbilityView() const { return FEnemyAbilityView(*this); }
+    
+    /** Get the stat scaling configuration */
+    const FEnemyStatScaling& GetStatScaling() const { return StatScaling; }
+    
+    /** Get the AI configuration, inherited from the nearest ancestor that defines one */
+    const FEnemyAIConfig& GetAIConfig() const;
+    
+    /** Get the visual customization, inherited from the nearest ancestor that defines one */
+    const FEnemyVisualCustomization& GetVisualCustomization() const;
+    
+    /** Whether this template defines its own base stats. Root templates always do */
+    bool DefinesBaseStats() const { return bOverrideBaseStats || ParentTemplate.IsNull(); }
+    
+    /** Whether this template defines its own AI configuration. Root templates always do */
+    bool DefinesAIConfig() const { return bOverrideAIConfig || ParentTemplate.IsNull(); }
+    
+    /** Whether this template defines its own visual customization. Root templates always do */
+    bool DefinesVisuals() const { return bOverrideVisuals || ParentTemplate.IsNull(); }
+    
+    /** Get the template tags */
+    const FGameplayTagContainer& GetTemplateTags() const { return TemplateTags; }
+    
+    /** Get the boss phases, inherited from the nearest ancestor that defines any */
+    const TArray<FEnemyPhaseDefinition>& GetPhases() const;
     //~ End Property Accessors
     
 protected:
@@ -74,14 +158,30 @@ protected:
     UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Template")
     TSoftObjectPtr<UEnemyTemplate> ParentTemplate;
     
+    /**
+     * Hard reference to ParentTemplate, kept in step with it by every edit
+     * Makes the parent an import of this package, so it is loaded before this template's PostLoad and a read
+     * of inherited blocks never has to load it.
+     */
+    UPROPERTY()
+    TObjectPtr<UEnemyTemplate> ParentTemplateReference;
+    
+    /** Enemy archetype */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Template")
+    EEnemyType EnemyType = EEnemyType::Melee;
+    
     /** Tags for categorizing and filtering templates */
     UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Template")
     FGameplayTagContainer TemplateTags;
     //~ End Template Properties
     
     //~ Begin Stats Properties
+    /** Whether BaseStats replaces the parent's stats instead of inheriting them */
+    UPROPERTY(EditAnywhere, Category = "Stats", meta = (EditCondition = "ParentTemplate != nullptr", EditConditionHides))
+    bool bOverrideBaseStats = false;
+    
     /** Base stats for this enemy type */
-    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Stats", meta = (ShowOnlyInnerProperties))
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Stats", meta = (ShowOnlyInnerProperties, EditCondition = "bOverrideBaseStats || ParentTemplate == nullptr"))
     FEnemyBaseStats BaseStats;
     
     /** Stat scaling configuration */
@@ -102,8 +202,12 @@ protected:
     UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Visual")
     TMap<int32, TSoftObjectPtr<UMaterialInterface>> MaterialOverrides;
     
+    /** Whether VisualCustomization replaces the parent's visuals instead of inheriting them */
+    UPROPERTY(EditAnywhere, Category = "Visual", meta = (EditCondition = "ParentTemplate != nullptr", EditConditionHides))
+    bool bOverrideVisuals = false;
+    
     /** Visual customization settings */
-    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Visual", meta = (ShowOnlyInnerProperties))
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Visual", meta = (ShowOnlyInnerProperties, EditCondition = "bOverrideVisuals || ParentTemplate == nullptr"))
     FEnemyVisualCustomization VisualCustomization;
     //~ End Visual Properties
     
@@ -112,45 +216,80 @@ protected:
     UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "AI")
     TSoftObjectPtr<UBehaviorTree> BehaviorTree;
     
+    /** Whether AIConfig replaces the parent's AI configuration instead of inheriting it */
+    UPROPERTY(EditAnywhere, Category = "AI", meta = (EditCondition = "ParentTemplate != nullptr", EditConditionHides))
+    bool bOverrideAIConfig = false;
+    
     /** AI configuration data */
-    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "AI", meta = (ShowOnlyInnerProperties))
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "AI", meta = (ShowOnlyInnerProperties, EditCondition = "bOverrideAIConfig || ParentTemplate == nullptr"))
     FEnemyAIConfig AIConfig;
     //~ End AI Properties
     
     //~ Begin Ability Properties
-    /** Abilities available to this enemy type */
+    /** Abilities this template adds to or replaces in its parent's set, matched by name */
     UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Abilities")
     TArray<FEnemyAbilityDefinition> Abilities;
     //~ End Ability Properties
     
+    //~ Begin Phase Properties
+    /** Phases after the opening one. Only Boss templates run them */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Phases", meta = (TitleProperty = "PhaseName"))
+    TArray<FEnemyPhaseDefinition> Phases;
+    //~ End Phase Properties
+    
 private:
     //~ Begin Helper Functions
-    /** Validate template dependencies */
-    bool ValidateTemplateDependencies(FString& OutError) const;
-    
     /** Validate visual assets */
-    bool ValidateVisualAssets(FString& OutError) const;
+    bool ValidateVisualAssets(FEnemyTemplateValidationResult& OutResult) const;
     
     /** Validate AI configuration */
-    bool ValidateAIConfig(FString& OutError) const;
+    bool ValidateAIConfiguration(FEnemyTemplateValidationResult& OutResult) const;
     
     /** Validate abilities */
-    bool ValidateAbilities(FString& OutError) const;
+    bool ValidateAbilities(FEnemyTemplateValidationResult& OutResult) const;
     
-    /** Apply inherited properties */
-    void ApplyInheritedProperties();
+    /** Apply visual settings to an instance, handing any LOD tiers to its visual LOD component */
+    void ApplyVisualCustomization(class ACharacter* EnemyInstance, const FEnemyVisualsFacet& VisualsFacet) const;
     
-    /** Merge ability definitions */
-    void MergeAbilityDefinitions(const TArray<FEnemyAbilityDefinition>& InheritedAbilities);
+    /** Apply AI settings to an instance */
+    void ApplyAIConfiguration(class ACharacter* EnemyInstance, const FEnemyResolvedAIConfig& Config) const;
+    
+    /** Validate into an existing result, reusing parent results already computed in this pass */
+    bool ValidateTemplateInto(FEnemyTemplateValidationResult& OutResult, TEnemyScratchMap<const UEnemyTemplate*, bool>& ValidatedTemplates) const;
+    
+    /** Grant an ability and its effects from a full definition */
+    void ApplyAbility(class UAbilitySystemComponent* AbilitySystem, const FEnemyAbilityDefinition& Ability) const;
+    
+    /** Grant an ability and its effects from resolved cold data */
+    void ApplyAbility(class UAbilitySystemComponent* AbilitySystem, const FEnemyAbilityColdData& Ability) const;
+    
+    /** Grant an ability class and apply its effects */
+    void GrantAbility(class UAbilitySystemComponent* AbilitySystem, const TSoftClassPtr<UGameplayAbility>& AbilityClass, const TArray<TSoftClassPtr<UGameplayEffect>>& AbilityEffects) const;
+    
+    /** Move this template to NewParent's entry of the children index */
+    void UpdateParentIndex(const FSoftObjectPath& NewParent);
+    
+    /** Re-index and republish this template, then republish the loaded descendants resolving through it */
+    void RefreshAfterEdit();
+
     //~ End Helper Functions
     
-    /** Cached inheritance chain */
-    UPROPERTY(Transient)
-    TArray<UEnemyTemplate*> CachedInheritanceChain;
+    /** Parent this template is listed under in the children index */
+    FSoftObjectPath IndexedParent;
+    
+    /** Set while undo routes through PostEditChangeProperty, so the refresh runs once */
+    bool bUndoingEdit = false;
     
-    /** Whether the inheritance chain needs updating */
-    UPROPERTY(Transient)
-    bool bInheritanceChainDirty;
+    /** Published resolved snapshot, swapped as a whole on edit */
+    FEnemyResolvedTemplatePtr ResolvedSnapshot;
+    
+    /** Guards the snapshot pointer swap; readers only hold it long enough to copy the pointer */
+    mutable FRWLock ResolvedSnapshotLock;
     
     friend class UEnemyTemplateManager;
+    friend class UEnemyCreatorTool;
+    friend class FEnemyTemplateBuilder;
+    
+    template <EEnemyType>
+    friend struct EnemyTemplate::TApplyResolved;
 }; 
\ No newline at end of file
@@ -0,0 +1,73 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "EnemyTemplate.h"
+
+/**
+ * Construction API for enemy templates
+ * Writes straight into the template: abilities are emplaced in place and text is moved rather than copied.
+ * Editing a block makes the template define it; untouched blocks stay inherited from the parent.
+ */
+class ENEMYCREATOR_API FEnemyTemplateBuilder
+{
+public:
+    explicit FEnemyTemplateBuilder(UEnemyTemplate* InTemplate);
+    
+    //~ Begin Identity
+    /** Set the template's unique name */
+    FEnemyTemplateBuilder& SetName(FName TemplateName);
+    
+    /** Set the template's display name */
+    FEnemyTemplateBuilder& SetDisplayName(FText&& DisplayName);
+    
+    /** Set the enemy archetype */
+    FEnemyTemplateBuilder& SetEnemyType(EEnemyType EnemyType);
+    
+    /** Set the parent template to inherit from */
+    FEnemyTemplateBuilder& SetParent(UEnemyTemplate* Parent);
+    
+    /** Add a template tag */
+    FEnemyTemplateBuilder& AddTag(const FGameplayTag& Tag);
+    //~ End Identity
+    
+    //~ Begin Blocks
+    /** Make the template define its own base stats, seeded from the inherited ones, and return them for editing */
+    FEnemyBaseStats& EditBaseStats();
+    
+    /** Make the template define its own AI configuration, seeded from the inherited one, and return it for editing */
+    FEnemyAIConfig& EditAIConfig();
+    
+    /** Make the template define its own visuals, seeded from the inherited ones, and return them for editing */
+    FEnemyVisualCustomization& EditVisuals();
+    //~ End Blocks
+    
+    //~ Begin Abilities
+    /** Clear the template's own abilities and reserve room for the expected count */
+    FEnemyTemplateBuilder& ResetAbilities(int32 ExpectedNum = 0);
+    
+    /** Construct an ability in place and return it for further setup */
+    FEnemyAbilityDefinition& EmplaceAbility(FName AbilityName, FText&& DisplayName, FText&& Description, float CooldownTime, float Range);
+    
+    /** Move a fully built ability into the template */
+    FEnemyTemplateBuilder& AddAbility(FEnemyAbilityDefinition&& Ability);
+    
+    /** The template's own abilities, for in-place edits */
+    TArrayView<FEnemyAbilityDefinition> EditAbilities();
+    //~ End Abilities
+    
+    //~ Begin Phases
+    /** Append a phase and return it for setup. Phases are entered in order */
+    FEnemyPhaseDefinition& EmplacePhase(FName PhaseName, float HealthThreshold, float TimeInPreviousPhase = 0.0f);
+    //~ End Phases
+    
+    /** Publish the resolved snapshot and return the finished template */
+    UEnemyTemplate* Publish();
+    
+    /** The template being built */
+    UEnemyTemplate* GetTemplate() const { return Template; }
+    
+private:
+    UEnemyTemplate* Template;
+};
@@ -0,0 +1,95 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "EnemyResolvedTemplate.h"
+
+class UEnemyTemplate;
+class UEnemyConfiguration;
+
+/** Part of a resolved template a difference belongs to. Combined as flags in FEnemyTemplateDiff::ChangedSections */
+enum class EEnemyDiffSection : uint8
+{
+    None        = 0,
+    Identity    = 1 << 0,
+    Stats       = 1 << 1,
+    Scaling     = 1 << 2,
+    AIConfig    = 1 << 3,
+    Visuals     = 1 << 4,
+    Abilities   = 1 << 5,
+    Phases      = 1 << 6,
+};
+ENUM_CLASS_FLAGS(EEnemyDiffSection)
+
+/** How much a diff records */
+enum class EEnemyDiffDetail : uint8
+{
+    /** Changed sections and ability names only; no strings are built. Enough for patches and deltas */
+    Sections,
+    
+    /** Every differing field with both values as text, for review tooling */
+    Fields
+};
+
+/** One field that differs between two resolved templates */
+struct FEnemyFieldDiff
+{
+    EEnemyDiffSection Section = EEnemyDiffSection::None;
+    
+    /** Element within a keyed collection: ability name, parameter name, map key or phase. None for plain fields */
+    FName Key;
+    
+    /** Field of the element or section. None when the whole element was added or removed */
+    FName Field;
+    
+    /** Values as text; empty on the side the element is absent from */
+    FString Before;
+    FString After;
+};
+
+/**
+ * Field-level difference between two resolved templates
+ * Works on snapshots rather than authored assets, so inheritance and configuration modifications are
+ * already applied and every keyed collection is a sorted flat array. Each collection is compared in
+ * one merge walk keyed by stable ids (ability names, parameter names), and interned facets that are
+ * the same allocation are skipped without looking inside.
+ */
+struct ENEMYCREATOR_API FEnemyTemplateDiff
+{
+    /** Compare two snapshots */
+    static FEnemyTemplateDiff Compare(const FEnemyResolvedTemplate& Before, const FEnemyResolvedTemplate& After, EEnemyDiffDetail Detail = EEnemyDiffDetail::Fields);
+    
+    /** Compare two templates' published snapshots. Returns false if either has not been published */
+    static bool CompareTemplates(const UEnemyTemplate& Before, const UEnemyTemplate& After, FEnemyTemplateDiff& OutDiff, EEnemyDiffDetail Detail = EEnemyDiffDetail::Fields);
+    
+    /** Compare a template against its resolved parent: what the child overrides. Returns false without a loaded parent */
+    static bool CompareToParent(const UEnemyTemplate& Template, FEnemyTemplateDiff& OutDiff, EEnemyDiffDetail Detail = EEnemyDiffDetail::Fields);
+    
+    /** Compare a configuration against its base template: what the configuration modifies. Game thread only */
+    static bool CompareToBase(const UEnemyConfiguration& Configuration, FEnemyTemplateDiff& OutDiff, EEnemyDiffDetail Detail = EEnemyDiffDetail::Fields);
+    
+    /**
+     * Visit every ability added, removed or redefined between two tables, matched by name
+     * Visitor receives (AbilityName, BeforeIndex, AfterIndex); an index is INDEX_NONE on the side the ability is absent from.
+     */
+    static void DiffAbilities(const FEnemyAbilityTable& Before, const FEnemyAbilityTable& After, TFunctionRef<void(FName, int32, int32)> Visitor);
+    
+    bool IsEmpty() const { return ChangedSections == EEnemyDiffSection::None; }
+    
+    /** Whether any of the given sections changed */
+    bool HasChanges(EEnemyDiffSection Sections) const { return EnumHasAnyFlags(ChangedSections, Sections); }
+    
+    /** One line per field, ordered by section then lexically by key and field, for logs and review tools. Requires Fields detail */
+    FString ToString() const;
+    
+    EEnemyDiffSection ChangedSections = EEnemyDiffSection::None;
+    
+    /** Abilities by name, recorded at either detail level */
+    TArray<FName> AddedAbilities;
+    TArray<FName> RemovedAbilities;
+    TArray<FName> ModifiedAbilities;
+    
+    /** Differing fields in section order, only with Fields detail */
+    TArray<FEnemyFieldDiff> Fields;
+};
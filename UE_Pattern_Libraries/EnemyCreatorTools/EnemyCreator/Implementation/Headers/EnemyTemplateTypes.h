@@ -6,6 +6,37 @@
 #include "GameplayTagContainer.h"
 #include "EnemyTemplateTypes.generated.h"
 
+/** Enemy archetype */
+UENUM(BlueprintType)
+enum class EEnemyType : uint8
+{
+    Melee       UMETA(DisplayName = "Melee"),
+    Ranged      UMETA(DisplayName = "Ranged"),
+    Support     UMETA(DisplayName = "Support"),
+    Elite       UMETA(DisplayName = "Elite"),
+    Boss        UMETA(DisplayName = "Boss"),
+    
+    MAX         UMETA(Hidden)
+};
+
+/** Aura an ability projects onto nearby allies */
+UENUM(BlueprintType)
+enum class EEnemyAuraType : uint8
+{
+    None        UMETA(DisplayName = "None"),
+    Heal        UMETA(DisplayName = "Heal"),
+    Buff        UMETA(DisplayName = "Buff")
+};
+
+/** Locomotion state an enemy follows while its animation is shared */
+UENUM(BlueprintType)
+enum class EEnemyAnimationState : uint8
+{
+    Idle        UMETA(DisplayName = "Idle"),
+    Move        UMETA(DisplayName = "Move"),
+    Attack      UMETA(DisplayName = "Attack")
+};
+
 /** Base stats for enemy types */
 USTRUCT(BlueprintType)
 struct ENEMYCREATOR_API FEnemyBaseStats
@@ -51,7 +82,7 @@ struct ENEMYCREATOR_API FEnemyStatScaling
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Scaling")
     TMap<FName, UCurveFloat*> StatScalingCurves;
     
-    /** Difficulty-based stat multipliers */
+    /** Difficulty-based stat multipliers, applied once per tier step above the default tier and divided out per step below */
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Scaling")
     TMap<FName, float> DifficultyMultipliers;
     
@@ -82,6 +113,10 @@ struct ENEMYCREATOR_API FEnemyAbilityDefinition
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Ability")
     FGameplayTagContainer AbilityTags;
     
+    /** Gameplay ability granted for this definition */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Ability")
+    TSoftClassPtr<UGameplayAbility> AbilityClass;
+    
     /** Cooldown time in seconds */
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Ability")
     float CooldownTime = 0.0f;
@@ -98,6 +133,14 @@ struct ENEMYCREATOR_API FEnemyAbilityDefinition
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Ability")
     bool bIsPassive = false;
     
+    /** Aura projected onto allies within Range. Only archetypes that run auras emit them */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Ability|Aura")
+    EEnemyAuraType AuraType = EEnemyAuraType::None;
+    
+    /** Health per pulse for heal auras, buff strength for buff auras. Overlapping auras add up */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Ability|Aura", meta = (EditCondition = "AuraType != EEnemyAuraType::None"))
+    float AuraMagnitude = 0.0f;
+    
     /** Animation montage for this ability */
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Ability")
     TSoftObjectPtr<UAnimMontage> AbilityMontage;
@@ -146,6 +189,82 @@ struct ENEMYCREATOR_API FEnemyAIConfig
     FGameplayTagContainer PersonalityTags;
 };
 
+/**
+ * Cheaper representation used when an enemy's significance is low
+ * Tiers are ordered from nearest to farthest. Any member left empty keeps the full-quality setting.
+ */
+USTRUCT(BlueprintType)
+struct ENEMYCREATOR_API FEnemyVisualLODTier
+{
+    GENERATED_BODY()
+    
+    /** Use this tier once significance falls to this value or below. Must decrease from tier to tier */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "LOD", meta = (ClampMin = "0.0", ClampMax = "1.0"))
+    float MaxSignificance = 0.5f;
+    
+    /** Simplified material for every slot. The visual parameters are applied to it once */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "LOD")
+    TSoftObjectPtr<UMaterialInterface> Material;
+    
+    /** Cheaper animation instance class */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "LOD")
+    TSoftClassPtr<UAnimInstance> AnimClass;
+    
+    /** Skip the mesh's post-process anim graph */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "LOD")
+    bool bDisablePostProcessGraph = false;
+    
+    /** Copy poses from the shared leaders for this skeleton instead of evaluating the graph. Needs animation sharing states */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "LOD")
+    bool bShareAnimation = false;
+    
+    /** Imposter or vertex-animation mesh shown instead of the skeletal mesh, which stops animating */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "LOD")
+    TSoftObjectPtr<UStaticMesh> ImposterMesh;
+    
+    bool operator==(const FEnemyVisualLODTier& Other) const
+    {
+        return MaxSignificance == Other.MaxSignificance
+            && Material == Other.Material
+            && AnimClass == Other.AnimClass
+            && bDisablePostProcessGraph == Other.bDisablePostProcessGraph
+            && bShareAnimation == Other.bShareAnimation
+            && ImposterMesh == Other.ImposterMesh;
+    }
+    
+    bool operator!=(const FEnemyVisualLODTier& Other) const { return !(*this == Other); }
+};
+
+/**
+ * Leader animations for one skeleton's shared states
+ * Every template on a skeleton contributes its animations to that skeleton's generated sharing setup;
+ * instances in a sharing LOD tier follow a leader instead of evaluating their own graph.
+ */
+USTRUCT(BlueprintType)
+struct ENEMYCREATOR_API FEnemyAnimationSharingStates
+{
+    GENERATED_BODY()
+    
+    /** Looping idle */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Animation Sharing")
+    TSoftObjectPtr<UAnimSequence> Idle;
+    
+    /** Looping locomotion */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Animation Sharing")
+    TSoftObjectPtr<UAnimSequence> Move;
+    
+    /** One-shot attack, played on demand and returning to the previous state */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Animation Sharing")
+    TSoftObjectPtr<UAnimSequence> Attack;
+    
+    /** Leaders per looping animation, each at a different time offset so followers do not move in lockstep */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Animation Sharing", meta = (ClampMin = "1", ClampMax = "8"))
+    int32 LeadersPerState = 2;
+    
+    /** Whether any state has an animation */
+    bool HasStates() const { return !Idle.IsNull() || !Move.IsNull() || !Attack.IsNull(); }
+};
+
 /** Visual customization options */
 USTRUCT(BlueprintType)
 struct ENEMYCREATOR_API FEnemyVisualCustomization
@@ -181,9 +300,60 @@ struct ENEMYCREATOR_API FEnemyVisualCustomization
     /** Material slot overrides */
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Visual")
     TMap<int32, TSoftObjectPtr<UMaterialInterface>> MaterialOverrides;
+    
+    /** Cheaper tiers selected at runtime by significance, nearest first */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Visual|LOD")
+    TArray<FEnemyVisualLODTier> LODTiers;
+    
+    /** Leader animations for tiers that share animation */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Visual|LOD")
+    FEnemyAnimationSharingStates AnimationSharing;
 };
 
-/** Template modification for creating variants */
+/**
+ * One boss phase after the opening one
+ * Phases run in array order and only move forward. Each is resolved once on top of the phase before it,
+ * so entering a phase swaps to a precomputed snapshot instead of re-resolving.
+ */
+USTRUCT(BlueprintType)
+struct ENEMYCREATOR_API FEnemyPhaseDefinition
+{
+    GENERATED_BODY()
+    
+    /** Phase name for debugging and gameplay cues */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Phase")
+    FName PhaseName;
+    
+    /** Enter when health falls to this fraction of maximum. 0 disables the health trigger */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Phase", meta = (ClampMin = "0.0", ClampMax = "1.0"))
+    float HealthThreshold = 0.0f;
+    
+    /** Enter after this many seconds in the previous phase. 0 disables the time trigger */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Phase", meta = (ClampMin = "0.0"))
+    float TimeInPreviousPhase = 0.0f;
+    
+    /** Abilities added in this phase, replacing any with the same name */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Phase")
+    TArray<FEnemyAbilityDefinition> Abilities;
+    
+    /** Stat multipliers relative to the previous phase, keyed by FEnemyBaseStats field name */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Phase")
+    TMap<FName, float> StatMultipliers;
+    
+    /** Whether Visuals replaces the previous phase's visuals */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Phase", meta = (InlineEditConditionToggle))
+    bool bOverrideVisuals = false;
+    
+    /** Visuals for this phase */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Phase", meta = (EditCondition = "bOverrideVisuals"))
+    FEnemyVisualCustomization Visuals;
+};
+
+/**
+ * Template modification for creating variants
+ * AI and visual blocks are copy-on-write: until their override flag is set the template's own block is
+ * used and nothing is copied. Ability modifications are already per-ability overrides.
+ */
 USTRUCT(BlueprintType)
 struct ENEMYCREATOR_API FEnemyTemplateModification
 {
@@ -197,12 +367,20 @@ struct ENEMYCREATOR_API FEnemyTemplateModification
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Modification")
     TMap<FName, FEnemyAbilityDefinition> ModifiedAbilities;
     
+    /** Whether AIModifications replaces the template's AI block */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Modification", meta = (InlineEditConditionToggle))
+    bool bOverrideAIConfig = false;
+    
     /** AI behavior modifications */
-    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Modification")
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Modification", meta = (EditCondition = "bOverrideAIConfig"))
     FEnemyAIConfig AIModifications;
     
+    /** Whether VisualModifications replaces the template's visual block */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Modification", meta = (InlineEditConditionToggle))
+    bool bOverrideVisuals = false;
+    
     /** Visual modifications */
-    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Modification")
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Modification", meta = (EditCondition = "bOverrideVisuals"))
     FEnemyVisualCustomization VisualModifications;
     
     /** Additional tags */
@@ -210,6 +388,29 @@ struct ENEMYCREATOR_API FEnemyTemplateModification
     FGameplayTagContainer AdditionalTags;
 };
 
+/** Measured cost of one enemy, captured by profiling and published through the asset registry */
+USTRUCT(BlueprintType)
+struct ENEMYCREATOR_API FEnemyCostReport
+{
+    GENERATED_BODY()
+    
+    /** Encounter points this enemy is worth */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Cost", meta = (ClampMin = "0.0"))
+    float Points = 1.0f;
+    
+    /** Game thread time to spawn and apply, in milliseconds */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Cost", meta = (ClampMin = "0.0"))
+    float SpawnCostMs = 0.0f;
+    
+    /** Average game thread time per frame while alive, in milliseconds */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Cost", meta = (ClampMin = "0.0"))
+    float RuntimeCostMs = 0.0f;
+    
+    /** Resident memory for the enemy's assets. Paid once however many instances spawn */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Cost", meta = (ClampMin = "0"))
+    int64 MemoryBytes = 0;
+};
+
 /** Template validation result */
 USTRUCT(BlueprintType)
 struct ENEMYCREATOR_API FEnemyTemplateValidationResult
@@ -0,0 +1,116 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/GCObject.h"
+#include "Containers/Ticker.h"
+#include "EnemyResolvedTemplate.h"
+
+class UTexture2D;
+
+/** Called once a requested thumbnail exists, with null if it could not be produced */
+DECLARE_DELEGATE_OneParam(FOnEnemyThumbnailRendered, UTexture2D* /*Thumbnail*/);
+
+/**
+ * Background renderer for still previews of enemy visuals
+ * Every request is keyed by FEnemyResolvedVisuals::GetContentHash and served from memory, from the disk
+ * cache under Saved/EnemyThumbnails, or by capturing it in one of a small pool of offscreen preview
+ * scenes. Templates and their assets stream in below default priority, captures are started a time slice
+ * per tick and read back once the render thread has finished them, and cache files are decoded and
+ * written on background threads. Nothing is ever applied to a live preview actor.
+ *
+ * The newest requests are served first, and a request nobody waits on any more can be cancelled, so
+ * scrolling through a long list does not leave a queue of rows that are no longer visible.
+ *
+ * When the process cannot render (-nullrhi, commandlets) each capture is replaced by a flat image of the
+ * visuals' color tint, so requests, caching and completion run the same way headlessly.
+ */
+class ENEMYCREATOR_API FEnemyThumbnailRenderer : public FGCObject
+{
+public:
+    FEnemyThumbnailRenderer();
+    virtual ~FEnemyThumbnailRenderer() override;
+    
+    /** Thumbnail already in memory for a content hash, or null */
+    UTexture2D* FindThumbnail(uint64 ContentHash) const;
+    
+    /**
+     * Request the thumbnail of a template asset
+     * @param ExpectedHash   Content hash published in the template's registry tags, so a cached thumbnail is found
+     *                       without loading the template. 0 if unknown; the template is then loaded to compute it.
+     * @return Request to pass to CancelRequest, or 0 if OnRendered has already been called
+     */
+    uint32 RequestTemplateThumbnail(const FSoftObjectPath& Template, uint64 ExpectedHash, FOnEnemyThumbnailRendered OnRendered);
+    
+    /** Request the thumbnail of visuals that are already resolved, such as a loaded template's or a configuration's. Same return as RequestTemplateThumbnail */
+    uint32 RequestThumbnail(const FEnemyVisualsFacet& Visuals, FOnEnemyThumbnailRendered OnRendered);
+    
+    /** Drop one pending request without calling it back. Work no other request waits on is abandoned, releasing its loads */
+    void CancelRequest(uint32 RequestId);
+    
+    /** Drop every pending request without calling it back */
+    void CancelAll();
+    
+    /** Requests not yet completed */
+    int32 GetNumPending() const { return Jobs.Num(); }
+    
+    /** Whether captures are replaced by flat placeholder images because nothing can render */
+    bool IsNullRenderer() const { return bNullRenderer; }
+    
+    //~ Begin FGCObject Interface
+    virtual void AddReferencedObjects(FReferenceCollector& Collector) override;
+    virtual FString GetReferencerName() const override;
+    //~ End FGCObject Interface
+
+private:
+    struct FJob;
+    struct FCaptureScene;
+    
+    /** Advance pending requests until the time slice runs out */
+    bool Tick(float DeltaTime);
+    
+    /** Move one request as far along as it can go this tick. Returns true once it has completed */
+    bool AdvanceJob(FJob& Job, double EndTime);
+    
+    /** Attach a callback to a pending request under a new request id */
+    uint32 AddCallback(FJob& Job, FOnEnemyThumbnailRendered&& OnRendered);
+    
+    /** Take a request out of the queue and its lookups */
+    TUniquePtr<FJob> RemoveJob(int32 Index);
+    
+    /** Turn pixels into the request's thumbnail and cache it; leaves Result null if the pixels are unusable */
+    void CompleteJob(FJob& Job, TArray64<FColor>&& Pixels, bool bWriteToDisk);
+    
+    /** Keep a thumbnail in memory, releasing the oldest beyond the configured limit */
+    void AddThumbnail(uint64 ContentHash, UTexture2D* Thumbnail);
+    
+    /** Cache file of a content hash at the current thumbnail size */
+    FString GetCacheFilename(uint64 ContentHash) const;
+    
+    /** Requests in the order they were made, served newest first */
+    TArray<TUniquePtr<FJob>> Jobs;
+    
+    /** Pending requests by the content hash they produce, once it is known */
+    TMap<uint64, FJob*> JobsByHash;
+    
+    /** Pending requests by the ids of the callers waiting on them */
+    TMap<uint32, FJob*> JobsByRequest;
+    
+    /** Next id handed out by AddCallback; 0 is never used */
+    uint32 NextRequestId = 1;
+    
+    /** Offscreen scenes, created on first capture */
+    TArray<TUniquePtr<FCaptureScene>> Scenes;
+    
+    /** Thumbnails in memory by content hash, and their insertion order for release */
+    TMap<uint64, TObjectPtr<UTexture2D>> Thumbnails;
+    TArray<uint64> ThumbnailOrder;
+    
+    FTSTicker::FDelegateHandle TickerHandle;
+    
+    /** Edge length the cache and scenes were set up for */
+    int32 ThumbnailSize;
+    
+    bool bNullRenderer;
+};
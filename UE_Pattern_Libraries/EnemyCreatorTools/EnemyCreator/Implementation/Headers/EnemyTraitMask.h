@@ -0,0 +1,71 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameplayTagContainer.h"
+#include "EnemyTemplateTypes.h"
+
+/** Bit layout of FEnemyTraitMask */
+namespace EnemyTraitBits
+{
+    /** One bit per EEnemyType, starting here */
+    constexpr int32 FirstTypeBit = 0;
+    
+    constexpr int32 UseCover = 8;
+    constexpr int32 CoordinateWithAllies = 9;
+    constexpr int32 HasPassiveAbility = 10;
+    constexpr int32 EmitsAura = 11;
+    
+    /** Tags from UEnemyCreatorSettings::TraitTags occupy the remaining bits in array order */
+    constexpr int32 FirstTagBit = 16;
+    constexpr int32 MaxTagBits = 64 - FirstTagBit;
+}
+
+/**
+ * 64-bit summary of an enemy's archetype, AI flags and mapped gameplay tags
+ * Computed once per resolved template or configuration, so runtime filters are mask tests over
+ * contiguous arrays instead of per-actor struct reads and tag container matching.
+ */
+struct ENEMYCREATOR_API FEnemyTraitMask
+{
+    uint64 Bits = 0;
+
+    FEnemyTraitMask() = default;
+    explicit FEnemyTraitMask(uint64 InBits) : Bits(InBits) {}
+
+    /** Mask with the bit for an archetype */
+    static FEnemyTraitMask ForType(EEnemyType Type) { return FEnemyTraitMask(1ull << (EnemyTraitBits::FirstTypeBit + static_cast<int32>(Type))); }
+
+    /** Mask with a single built-in bit */
+    static FEnemyTraitMask ForBit(int32 Bit) { return FEnemyTraitMask(1ull << Bit); }
+
+    /** Mask with the bit for a configured trait tag; empty if the tag is not mapped */
+    static FEnemyTraitMask ForTag(const FGameplayTag& Tag);
+
+    /** Mask with a bit for every configured trait tag present (or with a child present) in the container */
+    static FEnemyTraitMask ForTags(const FGameplayTagContainer& Tags);
+
+    /** Compute the mask for an archetype with its AI block and tags */
+    static FEnemyTraitMask Build(EEnemyType Type, bool bUseCover, bool bCoordinateWithAllies, bool bHasPassiveAbility, bool bEmitsAura, const FGameplayTagContainer& Tags);
+
+    /** Whether every required bit is set and no excluded bit is */
+    FORCEINLINE bool Matches(FEnemyTraitMask Required, FEnemyTraitMask Excluded = FEnemyTraitMask()) const
+    {
+        return (Bits & Required.Bits) == Required.Bits && (Bits & Excluded.Bits) == 0;
+    }
+
+    FEnemyTraitMask operator|(FEnemyTraitMask Other) const { return FEnemyTraitMask(Bits | Other.Bits); }
+    FEnemyTraitMask& operator|=(FEnemyTraitMask Other) { Bits |= Other.Bits; return *this; }
+    bool operator==(FEnemyTraitMask Other) const { return Bits == Other.Bits; }
+    bool operator!=(FEnemyTraitMask Other) const { return Bits != Other.Bits; }
+};
+
+namespace EnemyTraitMask
+{
+    /**
+     * Collect the indices of every mask matching Required/Excluded
+     * Branch-free inner test over a contiguous array, written so the compiler can vectorize it.
+     */
+    ENEMYCREATOR_API void Filter(TArrayView<const uint64> Masks, FEnemyTraitMask Required, FEnemyTraitMask Excluded, TArray<int32>& OutIndices);
+}
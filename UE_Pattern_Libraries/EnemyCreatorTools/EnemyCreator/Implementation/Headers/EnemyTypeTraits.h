@@ -0,0 +1,135 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "EnemyTemplateTypes.h"
+
+class FEnemyTemplateBuilder;
+
+/** Authoring defaults for one archetype, kept as plain constants so each type's table is fixed at compile time */
+struct FEnemyTypeDefaults
+{
+    float Health;
+    float Damage;
+    float Speed;
+    float AttackSpeed;
+    float Defense;
+    float CriticalChance;
+    float CriticalMultiplier;
+    
+    float AggressionLevel;
+    float PreferredRange;
+    bool bUseCover;
+    bool bCoordinateWithAllies;
+    
+    float VisualScale;
+    float BasicAttackRange;
+};
+
+/**
+ * Compile-time description of an enemy archetype
+ * Each specialization carries its defaults and the features it supports. Per-type code paths are
+ * instantiated from these traits, so an archetype only contains the stages it actually has.
+ */
+template <EEnemyType Type>
+struct TEnemyTypeTraits;
+
+template <>
+struct TEnemyTypeTraits<EEnemyType::Melee>
+{
+    static constexpr bool bHasPhases = false;
+    static constexpr bool bHasAuras = false;
+    
+    static constexpr FEnemyTypeDefaults Defaults = { 100.0f, 25.0f, 400.0f, 1.0f, 15.0f, 0.05f, 2.0f, 0.8f, 200.0f, false, true, 1.0f, 200.0f };
+    
+    /** Add the archetype's signature abilities */
+    static void AddDefaultAbilities(FEnemyTemplateBuilder& Builder);
+};
+
+template <>
+struct TEnemyTypeTraits<EEnemyType::Ranged>
+{
+    static constexpr bool bHasPhases = false;
+    static constexpr bool bHasAuras = false;
+    
+    static constexpr FEnemyTypeDefaults Defaults = { 80.0f, 20.0f, 350.0f, 0.8f, 10.0f, 0.1f, 2.5f, 0.4f, 800.0f, true, true, 1.0f, 800.0f };
+    
+    /** Add the archetype's signature abilities */
+    static void AddDefaultAbilities(FEnemyTemplateBuilder& Builder);
+};
+
+template <>
+struct TEnemyTypeTraits<EEnemyType::Support>
+{
+    static constexpr bool bHasPhases = false;
+    
+    /** Projects heal and buff auras onto nearby allies */
+    static constexpr bool bHasAuras = true;
+    
+    static constexpr FEnemyTypeDefaults Defaults = { 90.0f, 15.0f, 375.0f, 0.9f, 12.0f, 0.03f, 1.8f, 0.2f, 600.0f, true, true, 1.0f, 200.0f };
+    
+    /** Add the archetype's signature abilities */
+    static void AddDefaultAbilities(FEnemyTemplateBuilder& Builder);
+};
+
+template <>
+struct TEnemyTypeTraits<EEnemyType::Elite>
+{
+    static constexpr bool bHasPhases = false;
+    static constexpr bool bHasAuras = false;
+    
+    static constexpr FEnemyTypeDefaults Defaults = { 200.0f, 35.0f, 425.0f, 1.2f, 25.0f, 0.15f, 2.8f, 0.7f, 400.0f, true, true, 1.5f, 200.0f };
+    
+    /** Add the archetype's signature abilities */
+    static void AddDefaultAbilities(FEnemyTemplateBuilder& Builder);
+};
+
+template <>
+struct TEnemyTypeTraits<EEnemyType::Boss>
+{
+    /** Runs the template's phases through a phase machine */
+    static constexpr bool bHasPhases = true;
+    static constexpr bool bHasAuras = false;
+    
+    static constexpr FEnemyTypeDefaults Defaults = { 500.0f, 50.0f, 350.0f, 0.7f, 40.0f, 0.2f, 3.0f, 0.9f, 300.0f, false, false, 2.0f, 200.0f };
+    
+    /** Add the archetype's signature abilities */
+    static void AddDefaultAbilities(FEnemyTemplateBuilder& Builder);
+};
+
+/**
+ * Table with one entry per archetype, taken from EntryType<Type>::Invoke for each type
+ * Indexing it by EEnemyType replaces a runtime switch with a single indirect call.
+ */
+template <typename FunctionType, template <EEnemyType> class EntryType>
+struct TEnemyTypeDispatchTable
+{
+    static constexpr FunctionType Entries[] =
+    {
+        &EntryType<EEnemyType::Melee>::Invoke,
+        &EntryType<EEnemyType::Ranged>::Invoke,
+        &EntryType<EEnemyType::Support>::Invoke,
+        &EntryType<EEnemyType::Elite>::Invoke,
+        &EntryType<EEnemyType::Boss>::Invoke
+    };
+    static_assert(UE_ARRAY_COUNT(Entries) == static_cast<uint32>(EEnemyType::MAX), "Dispatch table needs one entry per archetype");
+    
+    static FunctionType Get(EEnemyType Type)
+    {
+        check(static_cast<uint32>(Type) < UE_ARRAY_COUNT(Entries));
+        return Entries[static_cast<uint32>(Type)];
+    }
+};
+
+namespace EnemyTypeTraits
+{
+    /** Fill stats, AI and visual defaults for an archetype */
+    ENEMYCREATOR_API void InitializeDefaults(FEnemyTemplateBuilder& Builder, EEnemyType Type);
+    
+    /** Add the common and signature abilities for an archetype */
+    ENEMYCREATOR_API void AddDefaultAbilities(FEnemyTemplateBuilder& Builder, EEnemyType Type);
+    
+    /** Whether an archetype projects its aura abilities onto nearby allies */
+    ENEMYCREATOR_API bool HasAuras(EEnemyType Type);
+}
@@ -0,0 +1,106 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/ActorComponent.h"
+#include "EnemyResolvedTemplate.h"
+#include "EnemyVisualLODComponent.generated.h"
+
+class UMaterialInstanceDynamic;
+class UStaticMeshComponent;
+struct FStreamableHandle;
+
+/**
+ * Switches an enemy between the visual LOD tiers of its resolved visuals
+ * Registers the owner with the world's USignificanceManager, which the game updates with its viewpoints,
+ * and moves to the farthest tier the owner's significance allows. Each tier's material instance is built
+ * the first time the tier is entered and reused on every later transition. Tier assets stream in the
+ * background; a tier whose assets have not arrived yet is skipped until they do. Tiers that share
+ * animation hand the owner to the animation sharing manager, which reads the same significance.
+ */
+UCLASS(ClassGroup = (EnemyCreator))
+class ENEMYCREATOR_API UEnemyVisualLODComponent : public UActorComponent
+{
+    GENERATED_BODY()
+
+public:
+    UEnemyVisualLODComponent();
+    
+    //~ Begin UActorComponent Interface
+    virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+    //~ End UActorComponent Interface
+    
+    /** Take over tier selection, capturing the owner's current mesh state as full quality */
+    void SetVisuals(const FEnemyVisualsFacet& InVisuals);
+    
+    /** Return to full quality and stop tracking significance */
+    void ResetVisuals();
+    
+    /** Switch tier. INDEX_NONE is full quality, otherwise an index into the visuals' LOD tiers */
+    void SetTier(int32 TierIndex);
+    
+    /** Current tier, INDEX_NONE at full quality */
+    int32 GetTier() const { return ActiveTier; }
+    
+    /** Distance from the nearest viewpoint at which significance reaches zero */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "LOD", meta = (ClampMin = "100.0", Units = "cm"))
+    float SignificanceDistance = 6000.0f;
+    
+    /** Margin significance must clear before moving back to a nearer tier, so boundary jitter does not swap tiers */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "LOD", meta = (ClampMin = "0.0", ClampMax = "0.5"))
+    float Hysteresis = 0.05f;
+
+protected:
+    /** Significance from one viewpoint: 1 at the viewpoint, 0 at SignificanceDistance */
+    float CalculateSignificance(const FTransform& Viewpoint) const;
+    
+    /** Tier for a significance, holding the current tier inside the hysteresis band */
+    int32 SelectTier(float Significance) const;
+    
+    /** Whether every asset a tier uses is loaded */
+    static bool IsTierLoaded(const FEnemyVisualLODTier& Tier);
+    
+    /** Tier material with the visual parameters applied, built on first use */
+    UMaterialInstanceDynamic* GetOrCreateTierMaterial(int32 TierIndex);
+    
+    /** Imposter mesh component, created on first use */
+    UStaticMeshComponent* GetOrCreateImposter();
+    
+    /** Start or stop following the shared leaders for the owner's skeleton */
+    void SetAnimationShared(bool bShared);
+    
+    void RegisterSignificance();
+    void UnregisterSignificance();
+    
+    /** Visuals whose tiers are in use */
+    TSharedPtr<const FEnemyResolvedVisuals, ESPMode::ThreadSafe> Visuals;
+    
+    /** Current tier */
+    int32 ActiveTier = INDEX_NONE;
+    
+    /** Whether the owner is registered with the significance manager */
+    bool bSignificanceRegistered = false;
+    
+    /** Whether the owner is following shared animation leaders */
+    bool bAnimationShared = false;
+    
+    /** Full-quality materials per slot, captured when the visuals were set */
+    UPROPERTY(Transient)
+    TArray<UMaterialInterface*> BaseMaterials;
+    
+    /** Full-quality animation class */
+    UPROPERTY(Transient)
+    TSubclassOf<UAnimInstance> BaseAnimClass;
+    
+    /** Cached material instance per tier, null until the tier is first entered */
+    UPROPERTY(Transient)
+    TArray<UMaterialInstanceDynamic*> TierMaterials;
+    
+    /** Imposter shown by tiers with an imposter mesh */
+    UPROPERTY(Transient)
+    UStaticMeshComponent* ImposterComponent = nullptr;
+    
+    /** Keeps streamed tier assets loaded while these visuals are in use */
+    TSharedPtr<FStreamableHandle> TierAssetsHandle;
+};
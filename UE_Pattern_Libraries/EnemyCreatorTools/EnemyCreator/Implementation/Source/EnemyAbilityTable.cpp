@@ -0,0 +1,160 @@
+#include "EnemyAbilityTable.h"
+
+void FEnemyAbilityTable::AddOrReplace(const FEnemyAbilityDefinition& Definition)
+{
+    int32 RecordIndex = Find(Definition.AbilityName);
+    if (RecordIndex == INDEX_NONE)
+    {
+        check(ColdData.Num() < MAX_uint16);
+
+        RecordIndex = Records.AddDefaulted();
+        Records[RecordIndex].ColdIndex = static_cast<uint16>(ColdData.AddDefaulted());
+    }
+
+    FEnemyAbilityRecord& Record = Records[RecordIndex];
+    Record.AbilityName = Definition.AbilityName;
+    Record.CooldownTime = Definition.CooldownTime;
+    Record.Range = Definition.Range;
+    Record.Cost = Definition.Cost;
+    Record.AuraType = Definition.AuraType;
+    Record.AuraMagnitude = Definition.AuraMagnitude;
+    Record.Flags = Definition.bIsPassive ? EEnemyAbilityRecordFlags::Passive : EEnemyAbilityRecordFlags::None;
+
+    FEnemyAbilityColdData& Cold = ColdData[Record.ColdIndex];
+    Cold.DisplayName = Definition.DisplayName;
+    Cold.Description = Definition.Description;
+    Cold.AbilityTags = Definition.AbilityTags;
+    Cold.AbilityClass = Definition.AbilityClass;
+    Cold.AbilityMontage = Definition.AbilityMontage;
+    Cold.AbilityEffects = Definition.AbilityEffects;
+}
+
+int32 FEnemyAbilityTable::Find(FName AbilityName) const
+{
+    for (int32 Index = 0; Index < Records.Num(); ++Index)
+    {
+        if (Records[Index].AbilityName == AbilityName)
+        {
+            return Index;
+        }
+    }
+
+    return INDEX_NONE;
+}
+
+FEnemyAbilityDefinition FEnemyAbilityTable::ToDefinition(int32 RecordIndex) const
+{
+    const FEnemyAbilityRecord& Record = Records[RecordIndex];
+    const FEnemyAbilityColdData& Cold = GetColdData(Record);
+
+    FEnemyAbilityDefinition Definition;
+    Definition.AbilityName = Record.AbilityName;
+    Definition.CooldownTime = Record.CooldownTime;
+    Definition.Range = Record.Range;
+    Definition.Cost = Record.Cost;
+    Definition.bIsPassive = Record.IsPassive();
+    Definition.AuraType = Record.AuraType;
+    Definition.AuraMagnitude = Record.AuraMagnitude;
+    Definition.DisplayName = Cold.DisplayName;
+    Definition.Description = Cold.Description;
+    Definition.AbilityTags = Cold.AbilityTags;
+    Definition.AbilityClass = Cold.AbilityClass;
+    Definition.AbilityMontage = Cold.AbilityMontage;
+    Definition.AbilityEffects = Cold.AbilityEffects;
+    return Definition;
+}
+
+int32 FEnemyAbilityTable::SelectAbilityInRange(float Distance, TArrayView<const float> CooldownRemaining, float AvailableResource) const
+{
+    check(CooldownRemaining.Num() == 0 || CooldownRemaining.Num() == Records.Num());
+
+    int32 BestIndex = INDEX_NONE;
+    float BestRange = MAX_flt;
+
+    for (int32 Index = 0; Index < Records.Num(); ++Index)
+    {
+        const FEnemyAbilityRecord& Record = Records[Index];
+        const bool bReady = CooldownRemaining.Num() == 0 || CooldownRemaining[Index] <= 0.0f;
+
+        // Prefer the tightest range that still reaches, so long-range abilities are saved for distant targets
+        if (!Record.IsPassive() && bReady && Record.Cost <= AvailableResource && Record.Range >= Distance && Record.Range < BestRange)
+        {
+            BestIndex = Index;
+            BestRange = Record.Range;
+        }
+    }
+
+    return BestIndex;
+}
+
+float FEnemyAbilityTable::GetMaxActiveRange() const
+{
+    float MaxRange = 0.0f;
+    for (const FEnemyAbilityRecord& Record : Records)
+    {
+        if (!Record.IsPassive())
+        {
+            MaxRange = FMath::Max(MaxRange, Record.Range);
+        }
+    }
+
+    return MaxRange;
+}
+
+bool FEnemyAbilityTable::IsSameEntry(int32 RecordIndex, const FEnemyAbilityTable& Other, int32 OtherRecordIndex) const
+{
+    const FEnemyAbilityRecord& A = Records[RecordIndex];
+    const FEnemyAbilityRecord& B = Other.Records[OtherRecordIndex];
+    if (A.AbilityName != B.AbilityName || A.CooldownTime != B.CooldownTime || A.Range != B.Range || A.Cost != B.Cost || A.Flags != B.Flags
+        || A.AuraType != B.AuraType || A.AuraMagnitude != B.AuraMagnitude)
+    {
+        return false;
+    }
+
+    const FEnemyAbilityColdData& ColdA = GetColdData(A);
+    const FEnemyAbilityColdData& ColdB = Other.GetColdData(B);
+    return ColdA.DisplayName.EqualTo(ColdB.DisplayName)
+        && ColdA.Description.EqualTo(ColdB.Description)
+        && ColdA.AbilityTags == ColdB.AbilityTags
+        && ColdA.AbilityClass == ColdB.AbilityClass
+        && ColdA.AbilityMontage == ColdB.AbilityMontage
+        && ColdA.AbilityEffects == ColdB.AbilityEffects;
+}
+
+bool FEnemyAbilityTable::operator==(const FEnemyAbilityTable& Other) const
+{
+    if (Records.Num() != Other.Records.Num())
+    {
+        return false;
+    }
+
+    for (int32 Index = 0; Index < Records.Num(); ++Index)
+    {
+        if (!IsSameEntry(Index, Other, Index))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+uint32 GetTypeHash(const FEnemyAbilityTable& Table)
+{
+    // Hot fields carry almost all the entropy; cold data only contributes its asset references
+    uint32 Hash = static_cast<uint32>(Table.Records.Num());
+    for (const FEnemyAbilityRecord& Record : Table.Records)
+    {
+        Hash = HashCombineFast(Hash, GetTypeHash(Record.AbilityName));
+        Hash = HashCombineFast(Hash, GetTypeHash(Record.CooldownTime));
+        Hash = HashCombineFast(Hash, GetTypeHash(Record.Range));
+        Hash = HashCombineFast(Hash, GetTypeHash(Record.Cost));
+        Hash = HashCombineFast(Hash, static_cast<uint32>(Record.Flags) | (static_cast<uint32>(Record.AuraType) << 8));
+        Hash = HashCombineFast(Hash, GetTypeHash(Record.AuraMagnitude));
+
+        const FEnemyAbilityColdData& Cold = Table.GetColdData(Record);
+        Hash = HashCombineFast(Hash, GetTypeHash(Cold.AbilityClass));
+        Hash = HashCombineFast(Hash, GetTypeHash(Cold.AbilityMontage));
+    }
+    return Hash;
+}
@@ -0,0 +1,60 @@
+#include "EnemyAbilityView.h"
+#include "EnemyTemplate.h"
+
+FEnemyAbilityView::FEnemyAbilityView(const UEnemyTemplate& Template)
+{
+    TArray<const UEnemyTemplate*, TInlineAllocator<8>> Chain;
+    for (const UEnemyTemplate* Current = &Template; Current && !Chain.Contains(Current); Current = Current->GetParentTemplate())
+    {
+        Chain.Add(Current);
+    }
+    
+    Layers.Reserve(Chain.Num());
+    for (int32 ChainIndex = Chain.Num() - 1; ChainIndex >= 0; --ChainIndex)
+    {
+        Layers.Add(Chain[ChainIndex]->GetAbilities());
+    }
+}
+
+const FEnemyAbilityDefinition* FEnemyAbilityView::Find(FName AbilityName) const
+{
+    // Search from the viewed template up so the first match is the most derived
+    for (int32 LayerIndex = Layers.Num() - 1; LayerIndex >= 0; --LayerIndex)
+    {
+        for (const FEnemyAbilityDefinition& Ability : Layers[LayerIndex])
+        {
+            if (Ability.AbilityName == AbilityName)
+            {
+                return &Ability;
+            }
+        }
+    }
+    
+    return nullptr;
+}
+
+int32 FEnemyAbilityView::Num() const
+{
+    int32 Count = 0;
+    for (FConstIterator It = begin(); It != end(); ++It)
+    {
+        ++Count;
+    }
+    return Count;
+}
+
+bool FEnemyAbilityView::IsShadowed(int32 LayerIndex, FName AbilityName) const
+{
+    for (int32 DerivedIndex = LayerIndex + 1; DerivedIndex < Layers.Num(); ++DerivedIndex)
+    {
+        for (const FEnemyAbilityDefinition& Ability : Layers[DerivedIndex])
+        {
+            if (Ability.AbilityName == AbilityName)
+            {
+                return true;
+            }
+        }
+    }
+    
+    return false;
+}
@@ -0,0 +1,146 @@
+#include "EnemyAnimationSharing.h"
+#include "EnemyTemplate.h"
+#include "EnemyCreatorSettings.h"
+#include "AnimationSharingManager.h"
+#include "AnimationSharingSetup.h"
+#include "AbilitySystemComponent.h"
+#include "AbilitySystemGlobals.h"
+#include "GameFramework/Character.h"
+
+namespace EnemyAnimationSharing
+{
+    /** Add an animation to a state's entry, creating the entry on first use. Animations already present are skipped */
+    static void AddStateAnimation(FPerSkeletonAnimationSharingSetup& SkeletonSetup, EEnemyAnimationState State, const TSoftObjectPtr<UAnimSequence>& Animation, int32 NumLeaders, TSubclassOf<UAnimSharingStateInstance> StateAnimClass)
+    {
+        UAnimSequence* Sequence = Animation.LoadSynchronous();
+        if (!Sequence)
+        {
+            return;
+        }
+        
+        const uint8 StateValue = static_cast<uint8>(State);
+        FAnimationStateEntry* Entry = SkeletonSetup.AnimationStates.FindByPredicate([StateValue](const FAnimationStateEntry& Existing) { return Existing.State == StateValue; });
+        if (!Entry)
+        {
+            Entry = &SkeletonSetup.AnimationStates.AddDefaulted_GetRef();
+            Entry->State = StateValue;
+            
+            // Attacks are one-shots started per request that hand back to the looping state they interrupted
+            Entry->bOnDemand = State == EEnemyAnimationState::Attack;
+            Entry->bReturnToPreviousState = Entry->bOnDemand;
+        }
+        
+        if (Entry->AnimationSetups.ContainsByPredicate([Sequence](const FAnimationSetup& Existing) { return Existing.AnimSequence == Sequence; }))
+        {
+            return;
+        }
+        
+        FAnimationSetup& AnimationSetup = Entry->AnimationSetups.AddDefaulted_GetRef();
+        AnimationSetup.AnimSequence = Sequence;
+        AnimationSetup.AnimBlueprint = StateAnimClass;
+        AnimationSetup.NumRandomizedInstances = Entry->bOnDemand ? 1 : NumLeaders;
+    }
+}
+
+UEnemyAnimationStateProcessor::UEnemyAnimationStateProcessor()
+{
+    AnimationStateEnum = StaticEnum<EEnemyAnimationState>();
+}
+
+void UEnemyAnimationStateProcessor::ProcessActorState_Implementation(int32& OutState, AActor* InActor, uint8 CurrentState, uint8 OnDemandState, bool& bShouldProcess)
+{
+    const UEnemyCreatorSettings* Settings = UEnemyCreatorSettings::Get();
+    
+    EEnemyAnimationState State = EEnemyAnimationState::Idle;
+    const UAbilitySystemComponent* AbilitySystem = UAbilitySystemGlobals::GetAbilitySystemComponentFromActor(InActor);
+    if (AbilitySystem && Settings->AttackAnimationTag.IsValid() && AbilitySystem->HasMatchingGameplayTag(Settings->AttackAnimationTag))
+    {
+        State = EEnemyAnimationState::Attack;
+    }
+    else if (InActor && InActor->GetVelocity().SizeSquared2D() > FMath::Square(Settings->MoveAnimationSpeed))
+    {
+        State = EEnemyAnimationState::Move;
+    }
+    
+    // An attack already playing on demand runs to its end and returns to the previous state by itself
+    if (State == EEnemyAnimationState::Attack && OnDemandState == static_cast<uint8>(EEnemyAnimationState::Attack))
+    {
+        State = static_cast<EEnemyAnimationState>(CurrentState);
+    }
+    
+    OutState = static_cast<int32>(State);
+    bShouldProcess = OutState != CurrentState;
+}
+
+int32 FEnemyAnimationSharing::BuildSetup(UAnimationSharingSetup& Setup, TConstArrayView<const UEnemyTemplate*> Templates)
+{
+    using namespace EnemyAnimationSharing;
+    
+    const UEnemyCreatorSettings* Settings = UEnemyCreatorSettings::Get();
+    const TSubclassOf<UAnimSharingStateInstance> StateAnimClass = Settings->SharedStateAnimClass.LoadSynchronous();
+    const TSubclassOf<UAnimSharingTransitionInstance> BlendAnimClass = Settings->SharedBlendAnimClass.LoadSynchronous();
+    
+    Setup.SkeletonSetups.Reset();
+    TMap<const USkeleton*, int32> SkeletonSetupIndices;
+    for (const UEnemyTemplate* Template : Templates)
+    {
+        if (!Template)
+        {
+            continue;
+        }
+        
+        const FEnemyVisualCustomization& Visuals = Template->GetVisualCustomization();
+        if (!Visuals.AnimationSharing.HasStates())
+        {
+            continue;
+        }
+        
+        USkeletalMesh* Mesh = Visuals.SkeletalMesh.LoadSynchronous();
+        USkeleton* Skeleton = Mesh ? Mesh->GetSkeleton() : nullptr;
+        if (!Skeleton)
+        {
+            continue;
+        }
+        
+        // The first template on a skeleton supplies the mesh the leaders render with
+        int32& SkeletonSetupIndex = SkeletonSetupIndices.FindOrAdd(Skeleton, INDEX_NONE);
+        if (SkeletonSetupIndex == INDEX_NONE)
+        {
+            SkeletonSetupIndex = Setup.SkeletonSetups.Num();
+            FPerSkeletonAnimationSharingSetup& NewSkeletonSetup = Setup.SkeletonSetups.AddDefaulted_GetRef();
+            NewSkeletonSetup.Skeleton = Skeleton;
+            NewSkeletonSetup.SkeletalMesh = Mesh;
+            NewSkeletonSetup.BlendAnimBlueprint = BlendAnimClass;
+            NewSkeletonSetup.StateProcessorClass = UEnemyAnimationStateProcessor::StaticClass();
+        }
+        
+        FPerSkeletonAnimationSharingSetup& SkeletonSetup = Setup.SkeletonSetups[SkeletonSetupIndex];
+        const FEnemyAnimationSharingStates& States = Visuals.AnimationSharing;
+        AddStateAnimation(SkeletonSetup, EEnemyAnimationState::Idle, States.Idle, States.LeadersPerState, StateAnimClass);
+        AddStateAnimation(SkeletonSetup, EEnemyAnimationState::Move, States.Move, States.LeadersPerState, StateAnimClass);
+        AddStateAnimation(SkeletonSetup, EEnemyAnimationState::Attack, States.Attack, States.LeadersPerState, StateAnimClass);
+    }
+    
+    return Setup.SkeletonSetups.Num();
+}
+
+UAnimationSharingManager* FEnemyAnimationSharing::GetManager(UWorld* World)
+{
+    if (!World || !UAnimationSharingManager::AnimationSharingEnabled())
+    {
+        return nullptr;
+    }
+    
+    if (UAnimationSharingManager* Manager = UAnimationSharingManager::GetManagerForWorld(World))
+    {
+        return Manager;
+    }
+    
+    const UAnimationSharingSetup* Setup = UEnemyCreatorSettings::Get()->AnimationSharingSetup.LoadSynchronous();
+    if (!Setup || !UAnimationSharingManager::CreateAnimationSharingManager(World, Setup))
+    {
+        return nullptr;
+    }
+    
+    return UAnimationSharingManager::GetManagerForWorld(World);
+}
@@ -0,0 +1,378 @@
+#include "EnemyBulkEdit.h"
+#include "EnemyTemplate.h"
+#include "EnemyTemplateBuilder.h"
+#include "EnemyFacetIntern.h"
+#include "Algo/AnyOf.h"
+#include "AssetRegistry/AssetData.h"
+#include "AssetRegistry/IAssetRegistry.h"
+
+#if WITH_EDITOR
+#include "ScopedTransaction.h"
+#endif
+
+namespace EnemyBulkEdit
+{
+    /** A stat field of FEnemyBaseStats and the range its property metadata allows */
+    struct FStatColumn
+    {
+        FName Name;
+        float FEnemyBaseStats::* Member;
+        float Min;
+        float Max;
+    };
+    
+    static const FStatColumn StatColumns[] =
+    {
+        { GET_MEMBER_NAME_CHECKED(FEnemyBaseStats, Health), &FEnemyBaseStats::Health, TNumericLimits<float>::Lowest(), TNumericLimits<float>::Max() },
+        { GET_MEMBER_NAME_CHECKED(FEnemyBaseStats, Damage), &FEnemyBaseStats::Damage, TNumericLimits<float>::Lowest(), TNumericLimits<float>::Max() },
+        { GET_MEMBER_NAME_CHECKED(FEnemyBaseStats, Speed), &FEnemyBaseStats::Speed, TNumericLimits<float>::Lowest(), TNumericLimits<float>::Max() },
+        { GET_MEMBER_NAME_CHECKED(FEnemyBaseStats, AttackSpeed), &FEnemyBaseStats::AttackSpeed, TNumericLimits<float>::Lowest(), TNumericLimits<float>::Max() },
+        { GET_MEMBER_NAME_CHECKED(FEnemyBaseStats, Defense), &FEnemyBaseStats::Defense, TNumericLimits<float>::Lowest(), TNumericLimits<float>::Max() },
+        { GET_MEMBER_NAME_CHECKED(FEnemyBaseStats, CriticalChance), &FEnemyBaseStats::CriticalChance, 0.0f, 1.0f },
+        { GET_MEMBER_NAME_CHECKED(FEnemyBaseStats, CriticalMultiplier), &FEnemyBaseStats::CriticalMultiplier, 1.0f, TNumericLimits<float>::Max() },
+    };
+    
+    static constexpr int32 NumStatColumns = UE_ARRAY_COUNT(StatColumns);
+    
+    static int32 FindStatColumn(FName StatName)
+    {
+        for (int32 Index = 0; Index < NumStatColumns; ++Index)
+        {
+            if (StatColumns[Index].Name == StatName)
+            {
+                return Index;
+            }
+        }
+        
+        return INDEX_NONE;
+    }
+    
+    /** Parse one where-clause condition into the query */
+    static bool ParseCondition(const FString& Condition, FEnemyTemplateQuery& Query, FString& OutError)
+    {
+        FString Key;
+        FString Value;
+        if (!Condition.Split(TEXT("="), &Key, &Value))
+        {
+            OutError = FString::Printf(TEXT("Expected Key=Value in condition '%s'"), *Condition);
+            return false;
+        }
+        Key.TrimStartAndEndInline();
+        Value.TrimStartAndEndInline();
+        
+        if (Key.Equals(TEXT("Type"), ESearchCase::IgnoreCase))
+        {
+            TArray<FString> TypeNames;
+            Value.ParseIntoArray(TypeNames, TEXT("|"));
+            for (const FString& TypeName : TypeNames)
+            {
+                const int64 TypeValue = StaticEnum<EEnemyType>()->GetValueByNameString(TypeName.TrimStartAndEnd());
+                if (TypeValue == INDEX_NONE || TypeValue == static_cast<int64>(EEnemyType::MAX))
+                {
+                    OutError = FString::Printf(TEXT("Unknown enemy type '%s'"), *TypeName);
+                    return false;
+                }
+                Query.Types.AddUnique(static_cast<EEnemyType>(TypeValue));
+            }
+            return true;
+        }
+        
+        if (Key.Equals(TEXT("Tag"), ESearchCase::IgnoreCase))
+        {
+            const FGameplayTag Tag = FGameplayTag::RequestGameplayTag(FName(*Value), false);
+            if (!Tag.IsValid())
+            {
+                OutError = FString::Printf(TEXT("Unknown gameplay tag '%s'"), *Value);
+                return false;
+            }
+            Query.RequiredTags.AddTag(Tag);
+            return true;
+        }
+        
+        OutError = FString::Printf(TEXT("Unknown condition '%s'; expected Type or Tag"), *Key);
+        return false;
+    }
+    
+    /** Run one operation over the selected rows of a column, clamping its results to the stat range. Kept branch-free per row so it vectorizes */
+    template <typename OperationType>
+    static void EvaluateColumn(TArrayView<float> Column, TConstArrayView<uint8> Selected, float Min, float Max, OperationType Operation)
+    {
+        float* RESTRICT Values = Column.GetData();
+        const uint8* RESTRICT Mask = Selected.GetData();
+        for (int32 Row = 0; Row < Column.Num(); ++Row)
+        {
+            const float Value = Values[Row];
+            Values[Row] = Mask[Row] ? FMath::Clamp(Operation(Value), Min, Max) : Value;
+        }
+    }
+    
+    static void EvaluateExpression(TArrayView<float> Column, TConstArrayView<uint8> Selected, float Min, float Max, EEnemyBulkEditOp Op, float Operand)
+    {
+        switch (Op)
+        {
+        case EEnemyBulkEditOp::Set:
+            EvaluateColumn(Column, Selected, Min, Max, [Operand](float) { return Operand; });
+            break;
+        case EEnemyBulkEditOp::Add:
+            EvaluateColumn(Column, Selected, Min, Max, [Operand](float Value) { return Value + Operand; });
+            break;
+        case EEnemyBulkEditOp::Subtract:
+            EvaluateColumn(Column, Selected, Min, Max, [Operand](float Value) { return Value - Operand; });
+            break;
+        case EEnemyBulkEditOp::Multiply:
+            EvaluateColumn(Column, Selected, Min, Max, [Operand](float Value) { return Value * Operand; });
+            break;
+        case EEnemyBulkEditOp::Divide:
+            EvaluateColumn(Column, Selected, Min, Max, [Operand](float Value) { return Value / Operand; });
+            break;
+        }
+    }
+    
+    void SelectTemplates(TArrayView<const FEnemyTemplateQuery> Queries, TArray<FAssetData>& OutAssets)
+    {
+        TArray<FAssetData> Assets;
+        IAssetRegistry::GetChecked().GetAssetsByClass(UEnemyTemplate::StaticClass()->GetClassPathName(), Assets, true);
+        
+        OutAssets.Reset();
+        for (FAssetData& AssetData : Assets)
+        {
+            if (Algo::AnyOf(Queries, [&AssetData](const FEnemyTemplateQuery& Query) { return Query.Matches(AssetData); }))
+            {
+                OutAssets.Add(MoveTemp(AssetData));
+            }
+        }
+    }
+    
+    FEnemyBulkEditResult Apply(TArrayView<UEnemyTemplate* const> Templates, TArrayView<const FEnemyBulkEditExpression> Expressions)
+    {
+        check(IsInGameThread());
+        
+        FEnemyBulkEditResult Result;
+        Result.NumSelected = Templates.Num();
+        const int32 NumRows = Templates.Num();
+        
+        // Columnar snapshot of every selected template's effective stats, inherited or not
+        TArray<float> Columns[NumStatColumns];
+        for (int32 Column = 0; Column < NumStatColumns; ++Column)
+        {
+            Columns[Column].SetNumUninitialized(NumRows);
+        }
+        for (int32 Row = 0; Row < NumRows; ++Row)
+        {
+            const FEnemyBaseStats& Stats = Templates[Row]->GetBaseStats();
+            for (int32 Column = 0; Column < NumStatColumns; ++Column)
+            {
+                Columns[Column][Row] = Stats.*StatColumns[Column].Member;
+            }
+        }
+        
+        TArray<float> OriginalColumns[NumStatColumns];
+        for (int32 Column = 0; Column < NumStatColumns; ++Column)
+        {
+            OriginalColumns[Column] = Columns[Column];
+        }
+        
+        // Registry tags may be stale, so each expression filters again on the loaded templates
+        TArray<uint8> Selected;
+        Selected.SetNumUninitialized(NumRows);
+        for (const FEnemyBulkEditExpression& Expression : Expressions)
+        {
+            const int32 Column = FindStatColumn(Expression.StatName);
+            if (Column == INDEX_NONE)
+            {
+                continue;
+            }
+            
+            for (int32 Row = 0; Row < NumRows; ++Row)
+            {
+                Selected[Row] = Expression.Where.Matches(*Templates[Row]) ? 1 : 0;
+            }
+            
+            // Only selected rows are clamped, so unselected templates keep their stats untouched
+            EvaluateExpression(Columns[Column], Selected, StatColumns[Column].Min, StatColumns[Column].Max, Expression.Op, Expression.Operand);
+        }
+        
+        TArray<int32> ChangedRows;
+        for (int32 Row = 0; Row < NumRows; ++Row)
+        {
+            for (int32 Column = 0; Column < NumStatColumns; ++Column)
+            {
+                if (Columns[Column][Row] != OriginalColumns[Column][Row])
+                {
+                    ChangedRows.Add(Row);
+                    break;
+                }
+            }
+        }
+        
+        if (ChangedRows.Num() == 0)
+        {
+            return Result;
+        }
+        
+        // One undo step for the whole pass; untouched templates are not even recorded
+        TArray<UEnemyTemplate*> ChangedTemplates;
+        ChangedTemplates.Reserve(ChangedRows.Num());
+        {
+#if WITH_EDITOR
+            FScopedTransaction Transaction(FText::Format(NSLOCTEXT("EnemyCreator", "BulkEditTransaction", "Bulk Edit {0} Enemy Templates"), ChangedRows.Num()));
+#endif
+            for (const int32 Row : ChangedRows)
+            {
+                UEnemyTemplate* Template = Templates[Row];
+                Template->Modify();
+                
+                FEnemyBaseStats& Stats = FEnemyTemplateBuilder(Template).EditBaseStats();
+                for (int32 Column = 0; Column < NumStatColumns; ++Column)
+                {
+                    Stats.*StatColumns[Column].Member = Columns[Column][Row];
+                }
+                
+                Template->MarkPackageDirty();
+                Result.TouchedPackages.AddUnique(Template->GetPackage());
+                ChangedTemplates.Add(Template);
+            }
+        }
+        
+        // Republish the changed templates and the loaded descendants that inherit stats from them, nothing else
+        TArray<UEnemyTemplate*> RepublishedTemplates;
+        TSet<UEnemyTemplate*> Republished;
+        TArray<UEnemyTemplate*> PendingTemplates = ChangedTemplates;
+        TArray<UEnemyTemplate*> Children;
+        while (PendingTemplates.Num() > 0)
+        {
+            UEnemyTemplate* Template = PendingTemplates.Pop(false);
+            bool bAlreadyRepublished = false;
+            Republished.Add(Template, &bAlreadyRepublished);
+            if (bAlreadyRepublished)
+            {
+                continue;
+            }
+            
+            Template->PublishResolvedTemplate();
+            RepublishedTemplates.Add(Template);
+            
+            Children.Reset();
+            Template->GetLoadedChildren(Children);
+            for (UEnemyTemplate* Child : Children)
+            {
+                if (!Child->DefinesBaseStats())
+                {
+                    PendingTemplates.Add(Child);
+                }
+            }
+        }
+        
+        // Every republish replaced a snapshot, so the facets only the old ones used are dead now
+        EnemyFacetIntern::Compact();
+        
+        // Inheriting descendants took the new stats too, so they are validated alongside the changed templates
+        TArray<FEnemyTemplateValidationResult> ValidationResults;
+        Result.NumChanged = ChangedTemplates.Num();
+        Result.NumInvalid = UEnemyTemplate::ValidateTemplates(TArrayView<const UEnemyTemplate* const>(RepublishedTemplates.GetData(), RepublishedTemplates.Num()), ValidationResults);
+        return Result;
+    }
+}
+
+bool FEnemyTemplateQuery::Matches(const FAssetData& AssetData) const
+{
+    FString TagValue;
+    if (Types.Num() > 0)
+    {
+        const int64 TypeValue = AssetData.GetTagValue(EnemyTemplateTags::EnemyType, TagValue) ? StaticEnum<EEnemyType>()->GetValueByNameString(TagValue) : INDEX_NONE;
+        if (!Types.Contains(static_cast<EEnemyType>(TypeValue)))
+        {
+            return false;
+        }
+    }
+    
+    if (!RequiredTags.IsEmpty())
+    {
+        FGameplayTagContainer TemplateTags;
+        if (AssetData.GetTagValue(EnemyTemplateTags::GameplayTags, TagValue))
+        {
+            TemplateTags.FromExportString(TagValue);
+        }
+        return TemplateTags.HasAll(RequiredTags);
+    }
+    
+    return true;
+}
+
+bool FEnemyTemplateQuery::Matches(const UEnemyTemplate& Template) const
+{
+    return (Types.Num() == 0 || Types.Contains(Template.GetEnemyType())) && Template.GetTemplateTags().HasAll(RequiredTags);
+}
+
+bool FEnemyBulkEditExpression::Parse(const FString& Text, FEnemyBulkEditExpression& OutExpression, FString& OutError)
+{
+    OutExpression = FEnemyBulkEditExpression();
+    
+    FString Assignment = Text;
+    FString WhereClause;
+    if (Text.Split(TEXT(" where "), &Assignment, &WhereClause, ESearchCase::IgnoreCase))
+    {
+        TArray<FString> Conditions;
+        WhereClause.ParseIntoArray(Conditions, TEXT(" and "));
+        for (const FString& Condition : Conditions)
+        {
+            if (!EnemyBulkEdit::ParseCondition(Condition, OutExpression.Where, OutError))
+            {
+                return false;
+            }
+        }
+    }
+    
+    // Compound operators first, so "*=" is not read as "=" with a stat name ending in '*'
+    static const TPair<const TCHAR*, EEnemyBulkEditOp> Operators[] =
+    {
+        { TEXT("*="), EEnemyBulkEditOp::Multiply },
+        { TEXT("/="), EEnemyBulkEditOp::Divide },
+        { TEXT("+="), EEnemyBulkEditOp::Add },
+        { TEXT("-="), EEnemyBulkEditOp::Subtract },
+        { TEXT("="), EEnemyBulkEditOp::Set },
+    };
+    
+    FString StatName;
+    FString OperandString;
+    bool bFoundOperator = false;
+    for (const TPair<const TCHAR*, EEnemyBulkEditOp>& Operator : Operators)
+    {
+        if (Assignment.Split(Operator.Key, &StatName, &OperandString))
+        {
+            OutExpression.Op = Operator.Value;
+            bFoundOperator = true;
+            break;
+        }
+    }
+    
+    if (!bFoundOperator)
+    {
+        OutError = FString::Printf(TEXT("Expected an assignment such as 'Damage *= 1.1' in '%s'"), *Text);
+        return false;
+    }
+    
+    StatName.TrimStartAndEndInline();
+    StatName.RemoveFromStart(TEXT("BaseStats."), ESearchCase::IgnoreCase);
+    OutExpression.StatName = FName(*StatName);
+    if (EnemyBulkEdit::FindStatColumn(OutExpression.StatName) == INDEX_NONE)
+    {
+        OutError = FString::Printf(TEXT("Unknown stat '%s'"), *StatName);
+        return false;
+    }
+    
+    OperandString.TrimStartAndEndInline();
+    if (!LexTryParseString(OutExpression.Operand, *OperandString))
+    {
+        OutError = FString::Printf(TEXT("Expected a number, got '%s'"), *OperandString);
+        return false;
+    }
+    
+    if (OutExpression.Op == EEnemyBulkEditOp::Divide && OutExpression.Operand == 0.0f)
+    {
+        OutError = TEXT("Division by zero");
+        return false;
+    }
+    
+    return true;
+}
@@ -1,6 +1,19 @@
 #include "EnemyCreatorTypes.h"
+#include "EnemyTemplate.h"
 #include "BaseEnemy.h"
+#include "EnemySpawnReplay.h"
+#include "EnemyRuntimeRegistry.h"
 #include "AbilitySystemComponent.h"
+#include "EnemyCreatorCustomVersion.h"
+
+namespace EnemyConfigurationTags
+{
+    const FName Points(TEXT("EnemyPoints"));
+    const FName SpawnCostMs(TEXT("EnemySpawnCostMs"));
+    const FName RuntimeCostMs(TEXT("EnemyRuntimeCostMs"));
+    const FName MemoryBytes(TEXT("EnemyMemoryBytes"));
+    const FName GameplayTags(TEXT("EnemyGameplayTags"));
+}
 
 void UEnemyConfiguration::InitializeFromTemplate(UEnemyTemplate* Template)
 {
@@ -12,18 +25,134 @@ void UEnemyConfiguration::InitializeFromTemplate(UEnemyTemplate* Template)
     // Store template reference
     BaseTemplate = Template;
     
-    // Initialize modifications with template defaults
-    Modifications.StatMultipliers.Empty();
-    Modifications.ModifiedAbilities.Empty();
+    // Start with no modifications; every block is shared with the template until edited
+    Modifications = FEnemyTemplateModification();
+    InvalidateResolvedConfiguration();
+}
+
+void UEnemyConfiguration::SetModifications(const FEnemyTemplateModification& NewModifications)
+{
+    Modifications = NewModifications;
+    InvalidateResolvedConfiguration();
+}
+
+void UEnemyConfiguration::Serialize(FArchive& Ar)
+{
+    Super::Serialize(Ar);
+    
+    Ar.UsingCustomVersion(FEnemyCreatorCustomVersion::GUID);
+}
+
+void UEnemyConfiguration::PostLoad()
+{
+    Super::PostLoad();
+    
+    // Newer configurations leave untouched blocks default-constructed with their flag clear, so only older ones migrate
+    if (GetLinkerCustomVersion(FEnemyCreatorCustomVersion::GUID) >= FEnemyCreatorCustomVersion::BlockOverrideFlags)
+    {
+        return;
+    }
     
-    // Copy AI config
-    Modifications.AIModifications = Template->GetAIConfig();
+    // Configurations saved before copy-on-write stored a full copy of the template's blocks without override flags.
+    // Only a block that differs from the template's is an override. If the template is not loaded, keeping the
+    // stored copy as an override is exactly what those configurations did before
+    if (Modifications.bOverrideAIConfig && Modifications.bOverrideVisuals)
+    {
+        return;
+    }
     
-    // Copy visual customization
-    Modifications.VisualModifications = Template->GetVisualCustomization();
+    const UEnemyTemplate* Template = BaseTemplate.Get();
+    if (!Modifications.bOverrideAIConfig)
+    {
+        const FEnemyAIConfig BaseAIConfig = Template ? Template->GetAIConfig() : FEnemyAIConfig();
+        Modifications.bOverrideAIConfig = !FEnemyAIConfig::StaticStruct()->CompareScriptStruct(&Modifications.AIModifications, &BaseAIConfig, PPF_None);
+    }
     
-    // Initialize with template's gameplay tags
-    Modifications.AdditionalTags = Template->GetTemplateTags();
+    if (!Modifications.bOverrideVisuals)
+    {
+        const FEnemyVisualCustomization BaseVisuals = Template ? Template->GetVisualCustomization() : FEnemyVisualCustomization();
+        Modifications.bOverrideVisuals = !FEnemyVisualCustomization::StaticStruct()->CompareScriptStruct(&Modifications.VisualModifications, &BaseVisuals, PPF_None);
+    }
+}
+
+void UEnemyConfiguration::GetAssetRegistryTags(TArray<FAssetRegistryTag>& OutTags) const
+{
+    Super::GetAssetRegistryTags(OutTags);
+    
+    OutTags.Emplace(EnemyConfigurationTags::Points, LexToString(CostReport.Points), FAssetRegistryTag::TT_Numerical);
+    OutTags.Emplace(EnemyConfigurationTags::SpawnCostMs, LexToString(CostReport.SpawnCostMs), FAssetRegistryTag::TT_Numerical);
+    OutTags.Emplace(EnemyConfigurationTags::RuntimeCostMs, LexToString(CostReport.RuntimeCostMs), FAssetRegistryTag::TT_Numerical);
+    OutTags.Emplace(EnemyConfigurationTags::MemoryBytes, LexToString(CostReport.MemoryBytes), FAssetRegistryTag::TT_Numerical);
+    
+    // Saving has the template loaded; fall back to the configuration's own tags if it is not
+    FGameplayTagContainer Tags = Modifications.AdditionalTags;
+    if (const UEnemyTemplate* Template = BaseTemplate.Get())
+    {
+        Tags.AppendTags(Template->GetTemplateTags());
+    }
+    OutTags.Emplace(EnemyConfigurationTags::GameplayTags, Tags.ToString(), FAssetRegistryTag::TT_Hidden);
+}
+
+void UEnemyConfiguration::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+    Super::PostEditChangeProperty(PropertyChangedEvent);
+    
+    InvalidateResolvedConfiguration();
+}
+
+FEnemyAIConfig& UEnemyConfiguration::EditAIConfig()
+{
+    if (!Modifications.bOverrideAIConfig)
+    {
+        if (const UEnemyTemplate* Template = BaseTemplate.Get())
+        {
+            Modifications.AIModifications = Template->GetAIConfig();
+        }
+        Modifications.bOverrideAIConfig = true;
+    }
+    
+    InvalidateResolvedConfiguration();
+    return Modifications.AIModifications;
+}
+
+FEnemyVisualCustomization& UEnemyConfiguration::EditVisuals()
+{
+    if (!Modifications.bOverrideVisuals)
+    {
+        if (const UEnemyTemplate* Template = BaseTemplate.Get())
+        {
+            Modifications.VisualModifications = Template->GetVisualCustomization();
+        }
+        Modifications.bOverrideVisuals = true;
+    }
+    
+    InvalidateResolvedConfiguration();
+    return Modifications.VisualModifications;
+}
+
+FEnemyResolvedTemplatePtr UEnemyConfiguration::GetResolvedConfiguration() const
+{
+    check(IsInGameThread());
+    
+    const UEnemyTemplate* Template = BaseTemplate.Get();
+    if (!Template)
+    {
+        return nullptr;
+    }
+    
+    FEnemyResolvedTemplatePtr TemplateSnapshot = Template->GetResolvedTemplate();
+    if (!TemplateSnapshot)
+    {
+        TemplateSnapshot = FEnemyResolvedTemplate::Build(*Template);
+    }
+    
+    if (!CachedResolved || CachedTemplateSerial != TemplateSnapshot->Serial)
+    {
+        CachedResolved = FEnemyResolvedTemplate::BuildVariant(TemplateSnapshot.ToSharedRef(), Modifications);
+        CachedTemplateSerial = TemplateSnapshot->Serial;
+    }
+    
+    return CachedResolved;
 }
 
 bool UEnemyConfiguration::ApplyConfiguration(ABaseEnemy* Enemy)
@@ -40,8 +169,82 @@ bool UEnemyConfiguration::ApplyConfiguration(ABaseEnemy* Enemy)
         return false;
     }
     
-    // Apply template with modifications
-    return Template->ApplyToInstance(Enemy, &Modifications);
+    // Apply the cached variant; untouched configurations apply the template's own snapshot
+    const FEnemyResolvedTemplatePtr Resolved = GetResolvedConfiguration();
+    if (!Resolved)
+    {
+        return false;
+    }
+    
+    if (EnemySpawnReplay::IsRecording())
+    {
+        EnemySpawnReplay::RecordSpawn(*this, *Enemy);
+    }
+    return Template->ApplyResolved(Enemy, Resolved.ToSharedRef());
+}
+
+bool UEnemyConfiguration::ApplyEliteConfiguration(ABaseEnemy* Enemy, TArrayView<const UEnemyEliteAffix* const> Affixes)
+{
+    if (Affixes.Num() == 0)
+    {
+        return ApplyConfiguration(Enemy);
+    }
+    
+    UEnemyTemplate* Template = BaseTemplate.Get();
+    const FEnemyResolvedTemplatePtr Resolved = Template ? GetResolvedConfiguration() : nullptr;
+    if (!Enemy || !Resolved)
+    {
+        return false;
+    }
+    
+    // Worlds without a registry, such as editor previews, compose without memoizing
+    UEnemyRuntimeRegistry* Registry = UWorld::GetSubsystem<UEnemyRuntimeRegistry>(Enemy->GetWorld());
+    FEnemyEliteComposer LocalComposer;
+    FEnemyEliteComposer& Composer = Registry ? Registry->GetEliteComposer() : LocalComposer;
+    const FEnemyResolvedTemplateRef Elite = Composer.Compose(Resolved.ToSharedRef(), Affixes);
+    
+    // Replays record the configuration only, so a replayed elite spawns without its affixes
+    if (EnemySpawnReplay::IsRecording())
+    {
+        EnemySpawnReplay::RecordSpawn(*this, *Enemy);
+    }
+    return Template->ApplyResolved(Enemy, Elite);
+}
+
+int32 UEnemyConfiguration::ApplyConfigurationToWave(TArrayView<ABaseEnemy* const> Enemies)
+{
+    UEnemyTemplate* Template = BaseTemplate.Get();
+    if (!Template)
+    {
+        return 0;
+    }
+    
+    const FEnemyResolvedTemplatePtr Resolved = GetResolvedConfiguration();
+    if (!Resolved)
+    {
+        return 0;
+    }
+    
+    int32 NumApplied = 0;
+    const bool bRecording = EnemySpawnReplay::IsRecording();
+    for (ABaseEnemy* Enemy : Enemies)
+    {
+        if (!Enemy)
+        {
+            continue;
+        }
+        
+        if (bRecording)
+        {
+            EnemySpawnReplay::RecordSpawn(*this, *Enemy);
+        }
+        if (Template->ApplyResolved(Enemy, Resolved.ToSharedRef()))
+        {
+            ++NumApplied;
+        }
+    }
+    
+    return NumApplied;
 }
 
 bool UEnemyConfiguration::ValidateConfiguration(FEnemyTemplateValidationResult& OutResult) const
@@ -83,7 +286,8 @@ bool UEnemyConfiguration::ValidateConfiguration(FEnemyTemplateValidationResult&
         }
     }
     
-    // Validate modified abilities
+    // Validate modified abilities against the layered view; no snapshot is needed for an editor check
+    const FEnemyAbilityView TemplateAbilities = Template->GetAbilityView();
     for (const auto& AbilityMod : Modifications.ModifiedAbilities)
     {
         if (AbilityMod.Key.IsNone())
@@ -92,18 +296,8 @@ bool UEnemyConfiguration::ValidateConfiguration(FEnemyTemplateValidationResult&
             return false;
         }
         
-        // Verify the ability exists in template
-        bool bAbilityFound = false;
-        for (const auto& TemplateAbility : Template->GetAbilities())
-        {
-            if (TemplateAbility.AbilityName == AbilityMod.Key)
-            {
-                bAbilityFound = true;
-                break;
-            }
-        }
-        
-        if (!bAbilityFound)
+        // Verify the ability exists somewhere in the template's chain
+        if (!TemplateAbilities.Contains(AbilityMod.Key))
         {
             OutResult.AddError(FText::Format(
                 NSLOCTEXT("EnemyCreator", "UnknownAbilityModification", "Modification targets unknown ability {0}"),
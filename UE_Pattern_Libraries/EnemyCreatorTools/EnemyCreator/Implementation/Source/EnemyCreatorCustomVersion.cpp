@@ -0,0 +1,6 @@
+#include "EnemyCreatorCustomVersion.h"
+#include "Serialization/CustomVersion.h"
+
+const FGuid FEnemyCreatorCustomVersion::GUID(0x6A3E1F52, 0x9C4B47D8, 0xA1E07B3D, 0x5F2C8E91);
+
+static FCustomVersionRegistration GRegisterEnemyCreatorCustomVersion(FEnemyCreatorCustomVersion::GUID, FEnemyCreatorCustomVersion::LatestVersion, TEXT("EnemyCreator"));
@@ -0,0 +1,98 @@
+#include "EnemyCreatorListItems.h"
+#include "EnemyTemplate.h"
+#include "AssetRegistry/AssetData.h"
+
+void UEnemyTemplateListItem::InitializeFromAssetData(const FAssetData& AssetData)
+{
+    Template = TSoftObjectPtr<UEnemyTemplate>(AssetData.GetSoftObjectPath());
+    
+    FString TagValue;
+    DisplayName = AssetData.GetTagValue(EnemyTemplateTags::DisplayName, TagValue) && !TagValue.IsEmpty()
+        ? FText::FromString(TagValue)
+        : FText::FromName(AssetData.AssetName);
+    
+    // Templates saved before the tags existed keep the defaults until they are resaved
+    if (AssetData.GetTagValue(EnemyTemplateTags::EnemyType, TagValue))
+    {
+        const int64 Value = StaticEnum<EEnemyType>()->GetValueByNameString(TagValue);
+        if (Value != INDEX_NONE)
+        {
+            EnemyType = static_cast<EEnemyType>(Value);
+        }
+    }
+    
+    if (AssetData.GetTagValue(EnemyTemplateTags::ParentTemplate, TagValue) && !TagValue.IsEmpty())
+    {
+        ParentTemplate = TSoftObjectPtr<UEnemyTemplate>(FSoftObjectPath(TagValue));
+    }
+    
+    if (AssetData.GetTagValue(EnemyTemplateTags::GameplayTags, TagValue))
+    {
+        TemplateTags.FromExportString(TagValue);
+    }
+    
+    AssetData.GetTagValue(EnemyTemplateTags::NumAbilities, NumAbilities);
+    
+    if (AssetData.GetTagValue(EnemyTemplateTags::VisualHash, TagValue))
+    {
+        VisualHash = FParse::HexNumber64(*TagValue);
+    }
+}
+
+void UEnemyAbilityListItem::Initialize(const FEnemyAbilitiesFacet& InAbilities, int32 InRecordIndex)
+{
+    Abilities = InAbilities;
+    RecordIndex = InRecordIndex;
+}
+
+const FEnemyAbilityRecord* UEnemyAbilityListItem::GetRecord() const
+{
+    return Abilities.IsValid() && Abilities->Records.IsValidIndex(RecordIndex) ? &Abilities->Records[RecordIndex] : nullptr;
+}
+
+FName UEnemyAbilityListItem::GetAbilityName() const
+{
+    const FEnemyAbilityRecord* Record = GetRecord();
+    return Record ? Record->AbilityName : NAME_None;
+}
+
+float UEnemyAbilityListItem::GetCooldownTime() const
+{
+    const FEnemyAbilityRecord* Record = GetRecord();
+    return Record ? Record->CooldownTime : 0.0f;
+}
+
+float UEnemyAbilityListItem::GetRange() const
+{
+    const FEnemyAbilityRecord* Record = GetRecord();
+    return Record ? Record->Range : 0.0f;
+}
+
+float UEnemyAbilityListItem::GetCost() const
+{
+    const FEnemyAbilityRecord* Record = GetRecord();
+    return Record ? Record->Cost : 0.0f;
+}
+
+bool UEnemyAbilityListItem::IsPassive() const
+{
+    const FEnemyAbilityRecord* Record = GetRecord();
+    return Record && Record->IsPassive();
+}
+
+FText UEnemyAbilityListItem::GetDisplayName() const
+{
+    const FEnemyAbilityRecord* Record = GetRecord();
+    if (!Record)
+    {
+        return FText::GetEmpty();
+    }
+    
+    const FText& DisplayName = Abilities->GetColdData(*Record).DisplayName;
+    return DisplayName.IsEmpty() ? FText::FromName(Record->AbilityName) : DisplayName;
+}
+
+FEnemyAbilityDefinition UEnemyAbilityListItem::GetDefinition() const
+{
+    return GetRecord() ? Abilities->ToDefinition(RecordIndex) : FEnemyAbilityDefinition();
+}
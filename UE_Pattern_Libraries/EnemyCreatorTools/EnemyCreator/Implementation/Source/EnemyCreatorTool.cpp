@@ -1,4 +1,17 @@
 #include "EnemyCreatorTool.h"
+#include "EnemyTemplateBuilder.h"
+#include "EnemyTypeTraits.h"
+#include "EnemyAnimationSharing.h"
+#include "EnemyCreatorSettings.h"
+#include "EnemyCreatorListItems.h"
+#include "EnemyBulkEdit.h"
+#include "EnemyTemplateDiff.h"
+#include "EnemyThumbnailRenderer.h"
+#include "AnimationSharingSetup.h"
+#include "AssetRegistry/IAssetRegistry.h"
+#include "Engine/AssetManager.h"
+#include "Engine/StreamableManager.h"
+#include "FileHelpers.h"
 #include "EnemyPreviewViewport.h"
 #include "EnemyPropertyCustomization.h"
 #include "OpenAIInterface.h"
@@ -15,13 +28,16 @@ UEnemyTemplate* UEnemyCreatorTool::CreateNewEnemyTemplate(const FString& Templat
 {
     // Create new template asset
     UEnemyTemplate* NewTemplate = NewObject<UEnemyTemplate>();
+    FEnemyTemplateBuilder Builder(NewTemplate);
     
     // Setup basic template properties
-    NewTemplate->TemplateName = FName(*TemplateName);
-    NewTemplate->DisplayName = FText::FromString(TemplateName);
+    Builder.SetName(FName(*TemplateName))
+        .SetDisplayName(FText::FromString(TemplateName))
+        .SetEnemyType(EnemyType);
     
     // Initialize with default values based on enemy type
-    InitializeTemplateDefaults(NewTemplate, EnemyType);
+    InitializeTemplateDefaults(Builder, EnemyType);
+    Builder.Publish();
     
     // Validate template
     FEnemyTemplateValidationResult ValidationResult;
@@ -74,6 +90,395 @@ void UEnemyCreatorTool::UpdatePreview(UEnemyConfiguration* Config)
     }
 }
 
+void UEnemyCreatorTool::BeginDestroy()
+{
+    CancelTemplateListPopulation();
+    if (FilesLoadedHandle.IsValid())
+    {
+        if (IAssetRegistry* AssetRegistry = IAssetRegistry::Get())
+        {
+            AssetRegistry->OnFilesLoaded().Remove(FilesLoadedHandle);
+        }
+        FilesLoadedHandle.Reset();
+    }
+    
+    if (OpenedTemplateHandle.IsValid())
+    {
+        OpenedTemplateHandle->CancelHandle();
+        OpenedTemplateHandle.Reset();
+    }
+    
+    // Preview scenes and the render fence wait must not be torn down inside garbage collection
+    ThumbnailRequests.Reset();
+    if (ThumbnailRenderer.IsValid())
+    {
+        ThumbnailRenderer->CancelAll();
+        FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateLambda([Renderer = MoveTemp(ThumbnailRenderer)](float) { return false; }));
+    }
+    
+    Super::BeginDestroy();
+}
+
+void UEnemyCreatorTool::RefreshTemplateList()
+{
+    CancelTemplateListPopulation();
+    TemplateItems.Reset();
+    RootTemplateItems.Reset();
+    bTemplateListPopulated = false;
+    
+    // Listing mid-scan would miss templates; try again once the scan completes
+    IAssetRegistry& AssetRegistry = IAssetRegistry::GetChecked();
+    if (AssetRegistry.IsLoadingAssets())
+    {
+        if (!FilesLoadedHandle.IsValid())
+        {
+            FilesLoadedHandle = AssetRegistry.OnFilesLoaded().AddWeakLambda(this, [this]()
+            {
+                IAssetRegistry::GetChecked().OnFilesLoaded().Remove(FilesLoadedHandle);
+                FilesLoadedHandle.Reset();
+                RefreshTemplateList();
+            });
+        }
+        return;
+    }
+    
+    // Only the registry's in-memory index is read here; rows are built over the following ticks
+    AssetRegistry.GetAssetsByClass(UEnemyTemplate::StaticClass()->GetClassPathName(), PendingTemplateAssets, true);
+    PendingTemplateAssets.Sort([](const FAssetData& A, const FAssetData& B)
+    {
+        return A.AssetName.LexicalLess(B.AssetName);
+    });
+    
+    TemplateItems.Reserve(PendingTemplateAssets.Num());
+    PopulateTickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateUObject(this, &UEnemyCreatorTool::PopulateTemplateList));
+}
+
+void UEnemyCreatorTool::GetTemplateChildren(UObject* Item, TArray<UObject*>& OutChildren) const
+{
+    OutChildren.Reset();
+    if (const UEnemyTemplateListItem* TemplateItem = Cast<UEnemyTemplateListItem>(Item))
+    {
+        OutChildren.Append(TemplateItem->Children);
+    }
+}
+
+void UEnemyCreatorTool::OpenTemplate(UEnemyTemplateListItem* Item)
+{
+    if (OpenedTemplateHandle.IsValid())
+    {
+        OpenedTemplateHandle->CancelHandle();
+        OpenedTemplateHandle.Reset();
+    }
+    AbilityItems.Reset();
+    
+    if (!Item || Item->Template.IsNull())
+    {
+        OpenedTemplate.Reset();
+        return;
+    }
+    
+    // The user is waiting on this one, so it goes ahead of any background streaming
+    OpenedTemplate = Item->Template;
+    OpenedTemplateHandle = UAssetManager::GetStreamableManager().RequestAsyncLoad(OpenedTemplate.ToSoftObjectPath(),
+        FStreamableDelegate::CreateUObject(this, &UEnemyCreatorTool::OnOpenedTemplateLoaded), FStreamableManager::AsyncLoadHighPriority);
+}
+
+UTexture2D* UEnemyCreatorTool::RequestThumbnail(UEnemyTemplateListItem* Item)
+{
+    if (!Item || Item->Template.IsNull())
+    {
+        return nullptr;
+    }
+    
+    // A loaded template may have unsaved visual edits the registry tag does not know about yet
+    FEnemyThumbnailRenderer& Renderer = GetThumbnailRenderer();
+    const UEnemyTemplate* LoadedTemplate = Item->Template.Get();
+    const FEnemyResolvedTemplatePtr Resolved = LoadedTemplate ? LoadedTemplate->GetResolvedTemplate() : nullptr;
+    const uint64 ContentHash = Resolved ? Resolved->Visuals->GetContentHash() : Item->VisualHash;
+    if (UTexture2D* Thumbnail = ContentHash != 0 ? Renderer.FindThumbnail(ContentHash) : nullptr)
+    {
+        return Thumbnail;
+    }
+    
+    if (ThumbnailRequests.Contains(Item))
+    {
+        return nullptr;
+    }
+    
+    const uint32 RequestId = Resolved
+        ? Renderer.RequestThumbnail(Resolved->Visuals, MakeThumbnailCallback(Item))
+        : Renderer.RequestTemplateThumbnail(Item->Template.ToSoftObjectPath(), Item->VisualHash, MakeThumbnailCallback(Item));
+    if (RequestId != 0)
+    {
+        ThumbnailRequests.Add(Item, RequestId);
+    }
+    return nullptr;
+}
+
+UTexture2D* UEnemyCreatorTool::RequestConfigurationThumbnail(UEnemyConfiguration* Configuration)
+{
+    const FEnemyResolvedTemplatePtr Resolved = Configuration ? Configuration->GetResolvedConfiguration() : nullptr;
+    if (!Resolved)
+    {
+        return nullptr;
+    }
+    
+    FEnemyThumbnailRenderer& Renderer = GetThumbnailRenderer();
+    if (UTexture2D* Thumbnail = Renderer.FindThumbnail(Resolved->Visuals->GetContentHash()))
+    {
+        return Thumbnail;
+    }
+    
+    if (ThumbnailRequests.Contains(Configuration))
+    {
+        return nullptr;
+    }
+    
+    const uint32 RequestId = Renderer.RequestThumbnail(Resolved->Visuals, MakeThumbnailCallback(Configuration));
+    if (RequestId != 0)
+    {
+        ThumbnailRequests.Add(Configuration, RequestId);
+    }
+    return nullptr;
+}
+
+void UEnemyCreatorTool::ReleaseThumbnail(UObject* Source)
+{
+    uint32 RequestId = 0;
+    if (ThumbnailRequests.RemoveAndCopyValue(Source, RequestId) && ThumbnailRenderer.IsValid())
+    {
+        ThumbnailRenderer->CancelRequest(RequestId);
+    }
+}
+
+void UEnemyCreatorTool::ShutdownThumbnails()
+{
+    ThumbnailRequests.Reset();
+    ThumbnailRenderer.Reset();
+}
+
+FEnemyThumbnailRenderer& UEnemyCreatorTool::GetThumbnailRenderer()
+{
+    if (!ThumbnailRenderer.IsValid())
+    {
+        ThumbnailRenderer = MakeShared<FEnemyThumbnailRenderer>();
+    }
+    return *ThumbnailRenderer;
+}
+
+FOnEnemyThumbnailRendered UEnemyCreatorTool::MakeThumbnailCallback(UObject* Source)
+{
+    return FOnEnemyThumbnailRendered::CreateWeakLambda(this, [this, WeakSource = TWeakObjectPtr<UObject>(Source)](UTexture2D* Thumbnail)
+    {
+        ThumbnailRequests.Remove(WeakSource);
+        if (UObject* RenderedSource = WeakSource.Get())
+        {
+            OnThumbnailReady.Broadcast(RenderedSource, Thumbnail);
+        }
+    });
+}
+
+bool UEnemyCreatorTool::PopulateTemplateList(float DeltaTime)
+{
+    const double EndTime = FPlatformTime::Seconds() + UEnemyCreatorSettings::Get()->TemplateListBudgetMs * 0.001;
+    
+    TArray<UEnemyTemplateListItem*> AddedItems;
+    while (PendingTemplateAssets.IsValidIndex(NextPendingAsset) && FPlatformTime::Seconds() < EndTime)
+    {
+        UEnemyTemplateListItem* Item = NewObject<UEnemyTemplateListItem>(this);
+        Item->InitializeFromAssetData(PendingTemplateAssets[NextPendingAsset++]);
+        TemplateItems.Add(Item);
+        AddedItems.Add(Item);
+    }
+    
+    if (AddedItems.Num() > 0)
+    {
+        OnTemplateItemsAdded.Broadcast(AddedItems);
+    }
+    
+    if (PendingTemplateAssets.IsValidIndex(NextPendingAsset))
+    {
+        return true;
+    }
+    
+    PopulateTickerHandle.Reset();
+    PendingTemplateAssets.Empty();
+    NextPendingAsset = 0;
+    
+    LinkTemplateTree();
+    bTemplateListPopulated = true;
+    OnTemplateListPopulated.Broadcast();
+    return false;
+}
+
+void UEnemyCreatorTool::LinkTemplateTree()
+{
+    TMap<FSoftObjectPath, UEnemyTemplateListItem*> ItemsByPath;
+    ItemsByPath.Reserve(TemplateItems.Num());
+    for (UEnemyTemplateListItem* Item : TemplateItems)
+    {
+        Item->Children.Reset();
+        ItemsByPath.Add(Item->Template.ToSoftObjectPath(), Item);
+    }
+    
+    // A parent that is missing or outside the registry leaves its children at the root
+    RootTemplateItems.Reset();
+    for (UEnemyTemplateListItem* Item : TemplateItems)
+    {
+        UEnemyTemplateListItem* Parent = ItemsByPath.FindRef(Item->ParentTemplate.ToSoftObjectPath());
+        if (Parent && Parent != Item)
+        {
+            Parent->Children.Add(Item);
+        }
+        else
+        {
+            RootTemplateItems.Add(Item);
+        }
+    }
+}
+
+void UEnemyCreatorTool::CancelTemplateListPopulation()
+{
+    if (PopulateTickerHandle.IsValid())
+    {
+        FTSTicker::GetCoreTicker().RemoveTicker(PopulateTickerHandle);
+        PopulateTickerHandle.Reset();
+    }
+    
+    PendingTemplateAssets.Empty();
+    NextPendingAsset = 0;
+}
+
+void UEnemyCreatorTool::OnOpenedTemplateLoaded()
+{
+    UEnemyTemplate* Template = OpenedTemplate.Get();
+    const FEnemyResolvedTemplatePtr Resolved = Template ? Template->GetResolvedTemplate() : nullptr;
+    if (!Resolved)
+    {
+        return;
+    }
+    
+    // Rows point into the resolved table; nothing is copied and no per-ability widget exists until a row scrolls into view
+    AbilityItems.Reset(Resolved->Abilities->Num());
+    for (int32 RecordIndex = 0; RecordIndex < Resolved->Abilities->Num(); ++RecordIndex)
+    {
+        UEnemyAbilityListItem* Item = NewObject<UEnemyAbilityListItem>(this);
+        Item->Initialize(Resolved->Abilities, RecordIndex);
+        AbilityItems.Add(Item);
+    }
+    
+    OnTemplateOpened.Broadcast(Template);
+}
+
+int32 UEnemyCreatorTool::BulkEditTemplates(const FString& Expressions, bool bSaveChangedPackages)
+{
+    TArray<FString> Lines;
+    Expressions.Replace(TEXT("\n"), TEXT(";")).ParseIntoArray(Lines, TEXT(";"));
+    
+    TArray<FEnemyBulkEditExpression> ParsedExpressions;
+    TArray<FEnemyTemplateQuery> Queries;
+    for (const FString& Line : Lines)
+    {
+        if (Line.TrimStartAndEnd().IsEmpty())
+        {
+            continue;
+        }
+        
+        FEnemyBulkEditExpression& Expression = ParsedExpressions.AddDefaulted_GetRef();
+        FString Error;
+        if (!FEnemyBulkEditExpression::Parse(Line, Expression, Error))
+        {
+            UE_LOG(LogEnemyEditor, Warning, TEXT("Bulk edit: %s"), *Error);
+            return INDEX_NONE;
+        }
+        Queries.Add(Expression.Where);
+    }
+    
+    // Only templates some expression can touch are loaded, in one batched request
+    TArray<FAssetData> Assets;
+    EnemyBulkEdit::SelectTemplates(Queries, Assets);
+    
+    TArray<FSoftObjectPath> Paths;
+    Paths.Reserve(Assets.Num());
+    for (const FAssetData& AssetData : Assets)
+    {
+        Paths.Add(AssetData.GetSoftObjectPath());
+    }
+    const TSharedPtr<FStreamableHandle> LoadHandle = UAssetManager::GetStreamableManager().RequestSyncLoad(Paths);
+    
+    TArray<UEnemyTemplate*> Templates;
+    Templates.Reserve(Paths.Num());
+    for (const FSoftObjectPath& Path : Paths)
+    {
+        if (UEnemyTemplate* Template = Cast<UEnemyTemplate>(Path.ResolveObject()))
+        {
+            Templates.Add(Template);
+        }
+    }
+    
+    const FEnemyBulkEditResult Result = EnemyBulkEdit::Apply(Templates, ParsedExpressions);
+    UE_LOG(LogEnemyEditor, Log, TEXT("Bulk edit changed %d of %d selected templates, %d no longer valid"), Result.NumChanged, Result.NumSelected, Result.NumInvalid);
+    
+    if (bSaveChangedPackages && Result.TouchedPackages.Num() > 0)
+    {
+        UEditorLoadingAndSavingUtils::SavePackages(Result.TouchedPackages, true);
+    }
+    
+    return Result.NumChanged;
+}
+
+FString UEnemyCreatorTool::DiffTemplates(UEnemyTemplate* Before, UEnemyTemplate* After) const
+{
+    FEnemyTemplateDiff Diff;
+    if (!Before || !After || !FEnemyTemplateDiff::CompareTemplates(*Before, *After, Diff))
+    {
+        return FString();
+    }
+    
+    return Diff.ToString();
+}
+
+FString UEnemyCreatorTool::DiffConfiguration(UEnemyConfiguration* Configuration) const
+{
+    FEnemyTemplateDiff Diff;
+    if (!Configuration || !FEnemyTemplateDiff::CompareToBase(*Configuration, Diff))
+    {
+        return FString();
+    }
+    
+    return Diff.ToString();
+}
+
+int32 UEnemyCreatorTool::GenerateAnimationSharingSetup()
+{
+    UAnimationSharingSetup* Setup = UEnemyCreatorSettings::Get()->AnimationSharingSetup.LoadSynchronous();
+    if (!Setup)
+    {
+        UE_LOG(LogEnemyEditor, Warning, TEXT("No animation sharing setup is configured in the Enemy Creator settings"));
+        return 0;
+    }
+    
+    TArray<FAssetData> Assets;
+    IAssetRegistry::GetChecked().GetAssetsByClass(UEnemyTemplate::StaticClass()->GetClassPathName(), Assets, true);
+    
+    TArray<const UEnemyTemplate*> Templates;
+    Templates.Reserve(Assets.Num());
+    for (const FAssetData& AssetData : Assets)
+    {
+        if (const UEnemyTemplate* Template = Cast<UEnemyTemplate>(AssetData.GetAsset()))
+        {
+            Templates.Add(Template);
+        }
+    }
+    
+    Setup->Modify();
+    const int32 NumSkeletons = FEnemyAnimationSharing::BuildSetup(*Setup, Templates);
+    Setup->MarkPackageDirty();
+    
+    UE_LOG(LogEnemyEditor, Log, TEXT("Generated animation sharing for %d skeletons from %d templates"), NumSkeletons, Templates.Num());
+    return NumSkeletons;
+}
+
 void UEnemyCreatorTool::SimulateAIBehavior()
 {
     if (!PreviewActor)
@@ -155,140 +560,20 @@ void UEnemyCreatorTool::RegisterAICallbacks()
     }
 }
 
-void UEnemyCreatorTool::InitializeTemplateDefaults(UEnemyTemplate* Template, EEnemyType EnemyType)
+void UEnemyCreatorTool::InitializeTemplateDefaults(FEnemyTemplateBuilder& Builder, EEnemyType EnemyType)
 {
-    if (!Template)
-    {
-        return;
-    }
-    
-    // Set base stats based on enemy type
-    FEnemyBaseStats& BaseStats = Template->GetBaseStats();
-    switch (EnemyType)
-    {
-        case EEnemyType::Melee:
-            BaseStats.Health = 100.0f;
-            BaseStats.Damage = 25.0f;
-            BaseStats.Speed = 400.0f;
-            BaseStats.AttackSpeed = 1.0f;
-            BaseStats.Defense = 15.0f;
-            BaseStats.CriticalChance = 0.05f;
-            BaseStats.CriticalMultiplier = 2.0f;
-            break;
-            
-        case EEnemyType::Ranged:
-            BaseStats.Health = 80.0f;
-            BaseStats.Damage = 20.0f;
-            BaseStats.Speed = 350.0f;
-            BaseStats.AttackSpeed = 0.8f;
-            BaseStats.Defense = 10.0f;
-            BaseStats.CriticalChance = 0.1f;
-            BaseStats.CriticalMultiplier = 2.5f;
-            break;
-            
-        case EEnemyType::Support:
-            BaseStats.Health = 90.0f;
-            BaseStats.Damage = 15.0f;
-            BaseStats.Speed = 375.0f;
-            BaseStats.AttackSpeed = 0.9f;
-            BaseStats.Defense = 12.0f;
-            BaseStats.CriticalChance = 0.03f;
-            BaseStats.CriticalMultiplier = 1.8f;
-            break;
-            
-        case EEnemyType::Elite:
-            BaseStats.Health = 200.0f;
-            BaseStats.Damage = 35.0f;
-            BaseStats.Speed = 425.0f;
-            BaseStats.AttackSpeed = 1.2f;
-            BaseStats.Defense = 25.0f;
-            BaseStats.CriticalChance = 0.15f;
-            BaseStats.CriticalMultiplier = 2.8f;
-            break;
-            
-        case EEnemyType::Boss:
-            BaseStats.Health = 500.0f;
-            BaseStats.Damage = 50.0f;
-            BaseStats.Speed = 350.0f;
-            BaseStats.AttackSpeed = 0.7f;
-            BaseStats.Defense = 40.0f;
-            BaseStats.CriticalChance = 0.2f;
-            BaseStats.CriticalMultiplier = 3.0f;
-            break;
-    }
-    
-    // Set AI configuration defaults
-    FEnemyAIConfig& AIConfig = Template->GetAIConfig();
-    switch (EnemyType)
-    {
-        case EEnemyType::Melee:
-            AIConfig.AggressionLevel = 0.8f;
-            AIConfig.PreferredRange = 200.0f;
-            AIConfig.bUseCover = false;
-            AIConfig.bCoordinateWithAllies = true;
-            break;
-            
-        case EEnemyType::Ranged:
-            AIConfig.AggressionLevel = 0.4f;
-            AIConfig.PreferredRange = 800.0f;
-            AIConfig.bUseCover = true;
-            AIConfig.bCoordinateWithAllies = true;
-            break;
-            
-        case EEnemyType::Support:
-            AIConfig.AggressionLevel = 0.2f;
-            AIConfig.PreferredRange = 600.0f;
-            AIConfig.bUseCover = true;
-            AIConfig.bCoordinateWithAllies = true;
-            break;
-            
-        case EEnemyType::Elite:
-            AIConfig.AggressionLevel = 0.7f;
-            AIConfig.PreferredRange = 400.0f;
-            AIConfig.bUseCover = true;
-            AIConfig.bCoordinateWithAllies = true;
-            break;
-            
-        case EEnemyType::Boss:
-            AIConfig.AggressionLevel = 0.9f;
-            AIConfig.PreferredRange = 300.0f;
-            AIConfig.bUseCover = false;
-            AIConfig.bCoordinateWithAllies = false;
-            break;
-    }
+    // Set stats, AI and visual defaults from the archetype's compile-time table
+    EnemyTypeTraits::InitializeDefaults(Builder, EnemyType);
     
     // Add type-specific gameplay tags
-    FGameplayTagContainer& Tags = Template->GetTemplateTags();
-    Tags.AddTag(FGameplayTag::RequestGameplayTag(FName(*FString::Printf(TEXT("Enemy.Type.%s"), *UEnum::GetValueAsString(EnemyType)))));
-    
-    // Initialize visual customization with defaults
-    FEnemyVisualCustomization& Visuals = Template->GetVisualCustomization();
-    switch (EnemyType)
-    {
-        case EEnemyType::Boss:
-            Visuals.Scale = FVector(2.0f);
-            break;
-            
-        case EEnemyType::Elite:
-            Visuals.Scale = FVector(1.5f);
-            break;
-            
-        default:
-            Visuals.Scale = FVector(1.0f);
-            break;
-    }
+    Builder.AddTag(FGameplayTag::RequestGameplayTag(FName(*FString::Printf(TEXT("Enemy.Type.%s"), *UEnum::GetValueAsString(EnemyType)))));
     
     // Load default assets based on type
-    LoadDefaultAssets(Template, EnemyType);
+    LoadDefaultAssets(Builder, EnemyType);
 }
 
-void UEnemyCreatorTool::LoadDefaultAssets(UEnemyTemplate* Template, EEnemyType EnemyType)
+void UEnemyCreatorTool::LoadDefaultAssets(FEnemyTemplateBuilder& Builder, EEnemyType EnemyType)
 {
-    if (!Template)
-    {
-        return;
-    }
-    
     // Construct paths based on enemy type
     FString TypeString = UEnum::GetValueAsString(EnemyType).RightChop(11); // Remove "EEnemyType::"
     FString BasePath = FString::Printf(TEXT("/Game/Enemies/%s/"), *TypeString);
@@ -297,144 +582,37 @@ void UEnemyCreatorTool::LoadDefaultAssets(UEnemyTemplate* Template, EEnemyType E
     FString MeshPath = BasePath + TEXT("SK_") + TypeString;
     if (USkeletalMesh* DefaultMesh = Cast<USkeletalMesh>(StaticLoadObject(USkeletalMesh::StaticClass(), nullptr, *MeshPath)))
     {
-        Template->GetVisualCustomization().SkeletalMesh = DefaultMesh;
+        Builder.EditVisuals().SkeletalMesh = DefaultMesh;
     }
     
     // Load default animation blueprint
     FString AnimBPPath = BasePath + TEXT("ABP_") + TypeString;
     if (UAnimBlueprint* DefaultAnimBP = Cast<UAnimBlueprint>(StaticLoadObject(UAnimBlueprint::StaticClass(), nullptr, *AnimBPPath)))
     {
-        Template->GetVisualCustomization().AnimationBlueprint = DefaultAnimBP;
+        Builder.EditVisuals().AnimationBlueprint = DefaultAnimBP;
     }
     
     // Load default behavior tree
     FString BTPath = BasePath + TEXT("BT_") + TypeString;
     if (UBehaviorTree* DefaultBT = Cast<UBehaviorTree>(StaticLoadObject(UBehaviorTree::StaticClass(), nullptr, *BTPath)))
     {
-        Template->GetAIConfig().BehaviorTree = DefaultBT;
+        Builder.EditAIConfig().BehaviorTree = DefaultBT;
     }
     
     // Load default abilities
-    LoadDefaultAbilities(Template, EnemyType);
+    LoadDefaultAbilities(Builder, EnemyType);
 }
 
-void UEnemyCreatorTool::LoadDefaultAbilities(UEnemyTemplate* Template, EEnemyType EnemyType)
+void UEnemyCreatorTool::LoadDefaultAbilities(FEnemyTemplateBuilder& Builder, EEnemyType EnemyType)
 {
-    if (!Template)
-    {
-        return;
-    }
-    
-    TArray<FEnemyAbilityDefinition>& Abilities = Template->GetAbilities();
-    Abilities.Empty();
+    // Abilities are constructed in place on the template; no definition is built locally and copied in
+    Builder.ResetAbilities(3);
     
-    // Add common abilities
-    FEnemyAbilityDefinition BasicAttack;
-    BasicAttack.AbilityName = TEXT("BasicAttack");
-    BasicAttack.DisplayName = NSLOCTEXT("EnemyAbilities", "BasicAttack", "Basic Attack");
-    BasicAttack.Description = NSLOCTEXT("EnemyAbilities", "BasicAttackDesc", "Basic melee or ranged attack");
-    BasicAttack.CooldownTime = 1.0f;
-    BasicAttack.Range = (EnemyType == EEnemyType::Ranged) ? 800.0f : 200.0f;
-    Abilities.Add(BasicAttack);
-    
-    // Add type-specific abilities
-    switch (EnemyType)
-    {
-        case EEnemyType::Melee:
-            {
-                FEnemyAbilityDefinition Charge;
-                Charge.AbilityName = TEXT("Charge");
-                Charge.DisplayName = NSLOCTEXT("EnemyAbilities", "Charge", "Charge Attack");
-                Charge.Description = NSLOCTEXT("EnemyAbilities", "ChargeDesc", "Charge towards target and deal damage");
-                Charge.CooldownTime = 8.0f;
-                Charge.Range = 600.0f;
-                Abilities.Add(Charge);
-                
-                FEnemyAbilityDefinition Cleave;
-                Cleave.AbilityName = TEXT("Cleave");
-                Cleave.DisplayName = NSLOCTEXT("EnemyAbilities", "Cleave", "Cleaving Strike");
-                Cleave.Description = NSLOCTEXT("EnemyAbilities", "CleaveDesc", "Wide sweeping attack that hits multiple targets");
-                Cleave.CooldownTime = 5.0f;
-                Cleave.Range = 250.0f;
-                Abilities.Add(Cleave);
-            }
-            break;
-            
-        case EEnemyType::Ranged:
-            {
-                FEnemyAbilityDefinition PowerShot;
-                PowerShot.AbilityName = TEXT("PowerShot");
-                PowerShot.DisplayName = NSLOCTEXT("EnemyAbilities", "PowerShot", "Power Shot");
-                PowerShot.Description = NSLOCTEXT("EnemyAbilities", "PowerShotDesc", "Charged shot that deals high damage");
-                PowerShot.CooldownTime = 10.0f;
-                PowerShot.Range = 1000.0f;
-                Abilities.Add(PowerShot);
-                
-                FEnemyAbilityDefinition Volley;
-                Volley.AbilityName = TEXT("Volley");
-                Volley.DisplayName = NSLOCTEXT("EnemyAbilities", "Volley", "Arrow Volley");
-                Volley.Description = NSLOCTEXT("EnemyAbilities", "VolleyDesc", "Fire multiple projectiles in an area");
-                Volley.CooldownTime = 15.0f;
-                Volley.Range = 800.0f;
-                Abilities.Add(Volley);
-            }
-            break;
-            
-        case EEnemyType::Support:
-            {
-                FEnemyAbilityDefinition Heal;
-                Heal.AbilityName = TEXT("Heal");
-                Heal.DisplayName = NSLOCTEXT("EnemyAbilities", "Heal", "Healing Pulse");
-                Heal.Description = NSLOCTEXT("EnemyAbilities", "HealDesc", "Heal nearby allies");
-                Heal.CooldownTime = 12.0f;
-                Heal.Range = 500.0f;
-                Abilities.Add(Heal);
-                
-                FEnemyAbilityDefinition Buff;
-                Buff.AbilityName = TEXT("Buff");
-                Buff.DisplayName = NSLOCTEXT("EnemyAbilities", "Buff", "Battle Cry");
-                Buff.Description = NSLOCTEXT("EnemyAbilities", "BuffDesc", "Increase damage of nearby allies");
-                Buff.CooldownTime = 20.0f;
-                Buff.Range = 600.0f;
-                Abilities.Add(Buff);
-            }
-            break;
-            
-        case EEnemyType::Elite:
-            {
-                FEnemyAbilityDefinition Ultimate;
-                Ultimate.AbilityName = TEXT("Ultimate");
-                Ultimate.DisplayName = NSLOCTEXT("EnemyAbilities", "Ultimate", "Elite Power");
-                Ultimate.Description = NSLOCTEXT("EnemyAbilities", "UltimateDesc", "Powerful ability unique to this elite enemy");
-                Ultimate.CooldownTime = 30.0f;
-                Ultimate.Range = 400.0f;
-                Abilities.Add(Ultimate);
-            }
-            break;
-            
-        case EEnemyType::Boss:
-            {
-                FEnemyAbilityDefinition Phase1;
-                Phase1.AbilityName = TEXT("Phase1");
-                Phase1.DisplayName = NSLOCTEXT("EnemyAbilities", "Phase1", "Phase 1 Ultimate");
-                Phase1.Description = NSLOCTEXT("EnemyAbilities", "Phase1Desc", "First phase special ability");
-                Phase1.CooldownTime = 45.0f;
-                Phase1.Range = 1000.0f;
-                Abilities.Add(Phase1);
-                
-                FEnemyAbilityDefinition Phase2;
-                Phase2.AbilityName = TEXT("Phase2");
-                Phase2.DisplayName = NSLOCTEXT("EnemyAbilities", "Phase2", "Phase 2 Ultimate");
-                Phase2.Description = NSLOCTEXT("EnemyAbilities", "Phase2Desc", "Second phase special ability");
-                Phase2.CooldownTime = 60.0f;
-                Phase2.Range = 1000.0f;
-                Abilities.Add(Phase2);
-            }
-            break;
-    }
+    // Add the common and type-specific abilities
+    EnemyTypeTraits::AddDefaultAbilities(Builder, EnemyType);
     
     // Load ability assets
-    for (FEnemyAbilityDefinition& Ability : Abilities)
+    for (FEnemyAbilityDefinition& Ability : Builder.EditAbilities())
     {
         FString AbilityPath = FString::Printf(TEXT("/Game/Enemies/%s/Abilities/GA_%s_%s"), 
             *UEnum::GetValueAsString(EnemyType).RightChop(11),
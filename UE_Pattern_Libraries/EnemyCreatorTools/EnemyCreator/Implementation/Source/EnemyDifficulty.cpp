@@ -0,0 +1,43 @@
+#include "EnemyDifficulty.h"
+#include "EnemyCreatorSettings.h"
+
+#include <atomic>
+
+namespace EnemyDifficulty
+{
+    /** Active tier, or INDEX_NONE until first set so the configured default applies */
+    static std::atomic<int32> ActiveTier{ INDEX_NONE };
+    
+    int32 GetNumTiers()
+    {
+        return FMath::Max(1, UEnemyCreatorSettings::Get()->DifficultyTiers.Num());
+    }
+    
+    int32 GetDefaultTier()
+    {
+        return FMath::Clamp(UEnemyCreatorSettings::Get()->DefaultDifficultyTier, 0, GetNumTiers() - 1);
+    }
+    
+    int32 GetActiveTier()
+    {
+        const int32 Tier = ActiveTier.load(std::memory_order_relaxed);
+        return Tier == INDEX_NONE ? GetDefaultTier() : Tier;
+    }
+    
+    void SetActiveTier(int32 Tier)
+    {
+        check(IsInGameThread());
+        
+        const int32 NewTier = FMath::Clamp(Tier, 0, GetNumTiers() - 1);
+        if (ActiveTier.exchange(NewTier, std::memory_order_relaxed) != NewTier)
+        {
+            OnTierChanged().Broadcast(NewTier);
+        }
+    }
+    
+    FOnEnemyDifficultyTierChanged& OnTierChanged()
+    {
+        static FOnEnemyDifficultyTierChanged Delegate;
+        return Delegate;
+    }
+}
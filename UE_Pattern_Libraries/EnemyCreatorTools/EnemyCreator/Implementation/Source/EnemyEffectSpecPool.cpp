@@ -0,0 +1,184 @@
+#include "EnemyEffectSpecPool.h"
+#include "AbilitySystemComponent.h"
+#include "AbilitySystemGlobals.h"
+
+namespace EnemyEffectSpecPool
+{
+    /** Whether an effect reads attributes from its source, which ties its spec to the applying ability system */
+    static bool CapturesSourceAttributes(const UGameplayEffect& Effect)
+    {
+        TArray<FGameplayEffectAttributeCaptureDefinition, TInlineAllocator<8>> CaptureDefinitions;
+        for (const FGameplayModifierInfo& Modifier : Effect.Modifiers)
+        {
+            Modifier.ModifierMagnitude.GetAttributeCaptureDefinitions(CaptureDefinitions);
+        }
+        for (const FGameplayEffectExecutionDefinition& Execution : Effect.Executions)
+        {
+            Execution.GetAttributeCaptureDefinitions(CaptureDefinitions);
+        }
+        
+        return CaptureDefinitions.ContainsByPredicate([](const FGameplayEffectAttributeCaptureDefinition& Definition)
+        {
+            return Definition.AttributeSource == EGameplayEffectAttributeCaptureSource::Source;
+        });
+    }
+}
+
+TUniquePtr<FGameplayEffectSpec> FEnemyEffectSpecPool::BuildSharedSpec(const UGameplayEffect& Effect, float Level, const UObject* SourceObject)
+{
+    if (EnemyEffectSpecPool::CapturesSourceAttributes(Effect))
+    {
+        return nullptr;
+    }
+    
+    // Placeholder context naming only the template; every apply replaces it with the target's own
+    FGameplayEffectContextHandle EffectContext(UAbilitySystemGlobals::Get().AllocGameplayEffectContext());
+    EffectContext.AddSourceObject(SourceObject);
+    
+    return MakeUnique<FGameplayEffectSpec>(&Effect, EffectContext, Level);
+}
+
+void FEnemyEffectSpecPool::SetTargetContext(FGameplayEffectSpec& Spec, UAbilitySystemComponent& Target, const UObject* SourceObject)
+{
+    FGameplayEffectContextHandle EffectContext = Target.MakeEffectContext();
+    EffectContext.AddSourceObject(SourceObject);
+    Spec.SetContext(EffectContext);
+}
+
+void FEnemyEffectSpecPool::AddReferencedObjects(FReferenceCollector& Collector)
+{
+    for (TPair<FKey, FEntry>& Pair : Entries)
+    {
+        if (Pair.Value.Spec)
+        {
+            Collector.AddPropertyReferences(FGameplayEffectSpec::StaticStruct(), Pair.Value.Spec.Get());
+        }
+    }
+}
+
+const FGameplayEffectSpec* FEnemyEffectSpecPool::Acquire(TSubclassOf<UGameplayEffect> EffectClass, float Level, const UObject* SourceObject)
+{
+    check(IsInGameThread());
+    
+    if (!EffectClass)
+    {
+        return nullptr;
+    }
+    
+    const FKey Key{ EffectClass.Get(), SourceObject, Level };
+    FEntry* Entry = Entries.Find(Key);
+    if (!Entry || !Entry->EffectClass.IsValid())
+    {
+        Entry = &Entries.Add(Key);
+        Entry->EffectClass = EffectClass.Get();
+        Entry->Spec = BuildSharedSpec(*EffectClass->GetDefaultObject<UGameplayEffect>(), Level, SourceObject);
+    }
+    
+    return Entry->Spec.Get();
+}
+
+void FEnemyEffectSpecPool::ApplyToTarget(UAbilitySystemComponent* Target, TSubclassOf<UGameplayEffect> EffectClass, float Level, const UObject* SourceObject)
+{
+    ApplyToTargets(MakeArrayView(&Target, 1), EffectClass, Level, SourceObject);
+}
+
+int32 FEnemyEffectSpecPool::ApplyToTargets(TArrayView<UAbilitySystemComponent* const> Targets, TSubclassOf<UGameplayEffect> EffectClass, float Level, const UObject* SourceObject)
+{
+    if (!EffectClass)
+    {
+        return 0;
+    }
+    
+    // One copy for the whole batch; only its context changes between targets
+    const FGameplayEffectSpec* SharedSpec = Acquire(EffectClass, Level, SourceObject);
+    TOptional<FGameplayEffectSpec> BatchSpec;
+    if (SharedSpec)
+    {
+        BatchSpec.Emplace(*SharedSpec);
+    }
+    
+    int32 NumApplied = 0;
+    for (UAbilitySystemComponent* Target : Targets)
+    {
+        if (!Target)
+        {
+            continue;
+        }
+        
+        if (BatchSpec)
+        {
+            SetTargetContext(*BatchSpec, *Target, SourceObject);
+            Target->ApplyGameplayEffectSpecToSelf(*BatchSpec);
+        }
+        else
+        {
+            // Source captures need the target's own context
+            FGameplayEffectContextHandle EffectContext = Target->MakeEffectContext();
+            EffectContext.AddSourceObject(SourceObject);
+            
+            const FGameplayEffectSpecHandle SpecHandle = Target->MakeOutgoingSpec(EffectClass, Level, EffectContext);
+            if (!SpecHandle.IsValid())
+            {
+                continue;
+            }
+            Target->ApplyGameplayEffectSpecToSelf(*SpecHandle.Data.Get());
+        }
+        ++NumApplied;
+    }
+    
+    return NumApplied;
+}
+
+void FEnemyEffectSpecPool::ApplyToTargetsWithMagnitudes(TArrayView<UAbilitySystemComponent* const> Targets, TArrayView<const float> Magnitudes, const FGameplayTag& MagnitudeTag, TSubclassOf<UGameplayEffect> EffectClass, float Level, const UObject* SourceObject, TArrayView<FActiveGameplayEffectHandle> OutHandles)
+{
+    check(Targets.Num() == Magnitudes.Num());
+    check(OutHandles.Num() == 0 || OutHandles.Num() == Targets.Num());
+    
+    if (!EffectClass)
+    {
+        return;
+    }
+    
+    // One mutable copy for the whole batch; applying copies it again into each target's container, context and magnitude included
+    const FGameplayEffectSpec* SharedSpec = Acquire(EffectClass, Level, SourceObject);
+    TOptional<FGameplayEffectSpec> BatchSpec;
+    if (SharedSpec)
+    {
+        BatchSpec.Emplace(*SharedSpec);
+    }
+    
+    for (int32 Index = 0; Index < Targets.Num(); ++Index)
+    {
+        UAbilitySystemComponent* Target = Targets[Index];
+        if (!Target)
+        {
+            continue;
+        }
+        
+        FActiveGameplayEffectHandle Handle;
+        if (BatchSpec)
+        {
+            SetTargetContext(*BatchSpec, *Target, SourceObject);
+            BatchSpec->SetSetByCallerMagnitude(MagnitudeTag, Magnitudes[Index]);
+            Handle = Target->ApplyGameplayEffectSpecToSelf(*BatchSpec);
+        }
+        else
+        {
+            FGameplayEffectContextHandle EffectContext = Target->MakeEffectContext();
+            EffectContext.AddSourceObject(SourceObject);
+            
+            const FGameplayEffectSpecHandle SpecHandle = Target->MakeOutgoingSpec(EffectClass, Level, EffectContext);
+            if (!SpecHandle.IsValid())
+            {
+                continue;
+            }
+            SpecHandle.Data->SetSetByCallerMagnitude(MagnitudeTag, Magnitudes[Index]);
+            Handle = Target->ApplyGameplayEffectSpecToSelf(*SpecHandle.Data.Get());
+        }
+        
+        if (OutHandles.Num() > 0)
+        {
+            OutHandles[Index] = Handle;
+        }
+    }
+}
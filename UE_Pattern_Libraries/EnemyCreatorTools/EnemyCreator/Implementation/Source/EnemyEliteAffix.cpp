@@ -0,0 +1,14 @@
+#include "EnemyEliteAffix.h"
+
+void UEnemyEliteAffix::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+    Super::PostEditChangeProperty(PropertyChangedEvent);
+    
+    OnAffixChanged().Broadcast(*this);
+}
+
+FOnEnemyEliteAffixChanged& UEnemyEliteAffix::OnAffixChanged()
+{
+    static FOnEnemyEliteAffixChanged Delegate;
+    return Delegate;
+}
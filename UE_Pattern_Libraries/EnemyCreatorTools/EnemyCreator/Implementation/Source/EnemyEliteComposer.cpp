@@ -0,0 +1,152 @@
+#include "EnemyEliteComposer.h"
+#include "EnemyEliteAffix.h"
+#include "EnemyTemplate.h"
+#include "EnemyFacetIntern.h"
+
+FEnemyResolvedTemplateRef FEnemyEliteComposer::Compose(const FEnemyResolvedTemplateRef& Base, TArrayView<const UEnemyEliteAffix* const> Affixes)
+{
+    check(IsInGameThread());
+    
+    // Canonical order by full path makes the key independent of roll order and keeps ability collisions deterministic;
+    // object names alone repeat across packages
+    TArray<TPair<FString, const UEnemyEliteAffix*>, TInlineAllocator<4>> AffixesByPath;
+    for (const UEnemyEliteAffix* Affix : Affixes)
+    {
+        if (Affix && !AffixesByPath.ContainsByPredicate([Affix](const TPair<FString, const UEnemyEliteAffix*>& Entry) { return Entry.Value == Affix; }))
+        {
+            AffixesByPath.Emplace(Affix->GetPathName(), Affix);
+        }
+    }
+    
+    if (AffixesByPath.Num() == 0)
+    {
+        return Base;
+    }
+    
+    AffixesByPath.Sort([](const TPair<FString, const UEnemyEliteAffix*>& A, const TPair<FString, const UEnemyEliteAffix*>& B) { return A.Key < B.Key; });
+    
+    FKey Key;
+    Key.BaseSerial = Base->Serial;
+    TArray<const UEnemyEliteAffix*, TInlineAllocator<4>> SortedAffixes;
+    for (const TPair<FString, const UEnemyEliteAffix*>& Entry : AffixesByPath)
+    {
+        Key.Affixes.Emplace(Entry.Key);
+        SortedAffixes.Add(Entry.Value);
+    }
+    
+    if (const FEntry* Existing = Entries.Find(Key))
+    {
+        return Existing->Composed;
+    }
+    
+    if (Entries.Num() >= CompactThreshold)
+    {
+        Compact();
+        CompactThreshold = FMath::Max(64, Entries.Num() * 2);
+    }
+    
+    FEnemyResolvedTemplateRef Composed = Build(Base, SortedAffixes);
+    Entries.Add(MoveTemp(Key), FEntry{ Base, Composed });
+    return Composed;
+}
+
+void FEnemyEliteComposer::Compact()
+{
+    for (auto It = Entries.CreateIterator(); It; ++It)
+    {
+        if (!It.Value().Base.IsValid())
+        {
+            It.RemoveCurrent();
+        }
+    }
+}
+
+void FEnemyEliteComposer::InvalidateAffix(const UEnemyEliteAffix& Affix)
+{
+    const FSoftObjectPath AffixPath(&Affix);
+    for (auto It = Entries.CreateIterator(); It; ++It)
+    {
+        if (It.Key().Affixes.Contains(AffixPath))
+        {
+            It.RemoveCurrent();
+        }
+    }
+}
+
+FEnemyResolvedTemplateRef FEnemyEliteComposer::Build(const FEnemyResolvedTemplateRef& Base, TArrayView<const UEnemyEliteAffix* const> SortedAffixes)
+{
+    // Only the facets an affix touches are rebuilt; the rest stay shared with Base
+    bool bTouchesVisuals = false;
+    bool bTouchesAbilities = false;
+    for (const UEnemyEliteAffix* Affix : SortedAffixes)
+    {
+        bTouchesVisuals |= Affix->GetColorTint() != FLinearColor::White || Affix->GetScaleMultiplier() != 1.0f;
+        bTouchesAbilities |= Affix->GetGrantedAbilities().Num() > 0;
+    }
+    
+    FEnemyVisualsFacet Visuals = Base->Visuals;
+    if (bTouchesVisuals)
+    {
+        FEnemyResolvedVisuals TintedVisuals = *Base->Visuals;
+        for (const UEnemyEliteAffix* Affix : SortedAffixes)
+        {
+            TintedVisuals.ColorTint *= Affix->GetColorTint();
+            TintedVisuals.Scale *= Affix->GetScaleMultiplier();
+        }
+        Visuals = EnemyFacetIntern::Intern(MoveTemp(TintedVisuals));
+    }
+    
+    FEnemyAbilitiesFacet Abilities = Base->Abilities;
+    if (bTouchesAbilities)
+    {
+        FEnemyAbilityTable ExtendedTable = *Base->Abilities;
+        for (const UEnemyEliteAffix* Affix : SortedAffixes)
+        {
+            for (const FEnemyAbilityDefinition& Ability : Affix->GetGrantedAbilities())
+            {
+                ExtendedTable.AddOrReplace(Ability);
+            }
+        }
+        Abilities = EnemyFacetIntern::Intern(MoveTemp(ExtendedTable));
+    }
+    
+    TSharedRef<FEnemyResolvedTemplate, ESPMode::ThreadSafe> Composed = MakeShared<FEnemyResolvedTemplate, ESPMode::ThreadSafe>(Visuals, Base->AIConfig, Abilities);
+    Composed->TemplateName = Base->TemplateName;
+    Composed->InheritanceChain = Base->InheritanceChain;
+    Composed->Serial = FEnemyResolvedTemplate::AllocateSerial();
+    Composed->EnemyType = Base->EnemyType;
+    Composed->StatScaling = Base->StatScaling;
+    
+    // The template's elite bonus applies once per elite, then each affix stacks multiplicatively
+    Composed->BaseStats = Base->BaseStats;
+    const auto ApplyMultipliers = [&Composed](const TMap<FName, float>& Multipliers)
+    {
+        for (const auto& Multiplier : Multipliers)
+        {
+            if (float* StatValue = UEnemyTemplate::GetStatValuePtr(Composed->BaseStats, Multiplier.Key))
+            {
+                *StatValue *= Multiplier.Value;
+            }
+        }
+    };
+    
+    ApplyMultipliers(Base->StatScaling.EliteMultipliers);
+    for (const UEnemyEliteAffix* Affix : SortedAffixes)
+    {
+        ApplyMultipliers(Affix->GetStatMultipliers());
+    }
+    
+    Composed->TemplateTags = Base->TemplateTags;
+    for (const UEnemyEliteAffix* Affix : SortedAffixes)
+    {
+        Composed->TemplateTags.AppendTags(Affix->GetAffixTags());
+    }
+    
+    // Affixed enemies also answer elite queries, whatever their archetype
+    Composed->TraitMask = FEnemyResolvedTemplate::BuildTraitMask(Composed->EnemyType, *Composed->AIConfig, *Composed->Abilities, Composed->TemplateTags)
+        | FEnemyTraitMask::ForType(EEnemyType::Elite);
+    Composed->BuildTierStats();
+    Composed->BuildPhases(Base->PhaseDefinitions);
+    
+    return Composed;
+}
@@ -0,0 +1,219 @@
+#include "EnemyEncounterSolver.h"
+#include "EnemyCreatorTypes.h"
+#include "AssetRegistry/IAssetRegistry.h"
+
+namespace EnemyEncounterSolver
+{
+    /** Running totals of a partial encounter */
+    struct FState
+    {
+        TArray<int32> Counts;
+        FEnemyCostReport Total;
+        int32 NumEnemies = 0;
+        
+        explicit FState(int32 NumCandidates)
+        {
+            Total.Points = 0.0f;
+            Counts.SetNumZeroed(NumCandidates);
+        }
+    };
+    
+    /** Whether adding one of Add, after removing one of Remove, keeps the state within budget */
+    static bool Fits(const FState& State, const TArray<FEnemyEncounterSolver::FCandidate>& Candidates, const FEnemyEncounterBudget& Budget, int32 Add, int32 Remove = INDEX_NONE)
+    {
+        const FEnemyCostReport& AddCost = Candidates[Add].Cost;
+        FEnemyCostReport Total = State.Total;
+        int32 NumEnemies = State.NumEnemies + 1;
+        int32 AddCount = State.Counts[Add] + 1;
+        
+        if (Remove != INDEX_NONE)
+        {
+            const FEnemyCostReport& RemoveCost = Candidates[Remove].Cost;
+            Total.Points -= RemoveCost.Points;
+            Total.SpawnCostMs -= RemoveCost.SpawnCostMs;
+            Total.RuntimeCostMs -= RemoveCost.RuntimeCostMs;
+            Total.MemoryBytes -= State.Counts[Remove] == 1 ? RemoveCost.MemoryBytes : 0;
+            --NumEnemies;
+        }
+        
+        // Memory is paid by the first instance only; every later instance shares the resident assets
+        Total.MemoryBytes += AddCount == 1 ? AddCost.MemoryBytes : 0;
+        
+        return Total.Points + AddCost.Points <= Budget.Points
+            && (Budget.SpawnCostMs <= 0.0f || Total.SpawnCostMs + AddCost.SpawnCostMs <= Budget.SpawnCostMs)
+            && (Budget.RuntimeCostMs <= 0.0f || Total.RuntimeCostMs + AddCost.RuntimeCostMs <= Budget.RuntimeCostMs)
+            && (Budget.MemoryBytes <= 0 || Total.MemoryBytes <= Budget.MemoryBytes)
+            && (Budget.MaxEnemies <= 0 || NumEnemies <= Budget.MaxEnemies)
+            && (Budget.MaxPerConfiguration <= 0 || AddCount <= Budget.MaxPerConfiguration);
+    }
+    
+    static void Add(FState& State, const FEnemyCostReport& Cost, int32 Index)
+    {
+        State.Total.MemoryBytes += State.Counts[Index] == 0 ? Cost.MemoryBytes : 0;
+        State.Total.Points += Cost.Points;
+        State.Total.SpawnCostMs += Cost.SpawnCostMs;
+        State.Total.RuntimeCostMs += Cost.RuntimeCostMs;
+        ++State.Counts[Index];
+        ++State.NumEnemies;
+    }
+    
+    static void Remove(FState& State, const FEnemyCostReport& Cost, int32 Index)
+    {
+        --State.Counts[Index];
+        --State.NumEnemies;
+        State.Total.MemoryBytes -= State.Counts[Index] == 0 ? Cost.MemoryBytes : 0;
+        State.Total.Points -= Cost.Points;
+        State.Total.SpawnCostMs -= Cost.SpawnCostMs;
+        State.Total.RuntimeCostMs -= Cost.RuntimeCostMs;
+    }
+    
+    /** Points per unit of budget consumed, with every constrained cost normalized to its limit */
+    static float GetDensity(const FEnemyCostReport& Cost, const FEnemyEncounterBudget& Budget)
+    {
+        float Weight = Cost.Points / Budget.Points;
+        Weight += Budget.SpawnCostMs > 0.0f ? Cost.SpawnCostMs / Budget.SpawnCostMs : 0.0f;
+        Weight += Budget.RuntimeCostMs > 0.0f ? Cost.RuntimeCostMs / Budget.RuntimeCostMs : 0.0f;
+        Weight += Budget.MemoryBytes > 0 ? static_cast<float>(static_cast<double>(Cost.MemoryBytes) / Budget.MemoryBytes) : 0.0f;
+        Weight += Budget.MaxEnemies > 0 ? 1.0f / Budget.MaxEnemies : 0.0f;
+        return Cost.Points / FMath::Max(Weight, UE_SMALL_NUMBER);
+    }
+    
+    /** Add the densest candidate that fits until none does. Order is sorted by density, densest first */
+    static void Fill(FState& State, const TArray<FEnemyEncounterSolver::FCandidate>& Candidates, TConstArrayView<int32> Order, const FEnemyEncounterBudget& Budget)
+    {
+        for (int32 Index : Order)
+        {
+            while (Fits(State, Candidates, Budget, Index))
+            {
+                Add(State, Candidates[Index].Cost, Index);
+            }
+        }
+    }
+}
+
+int32 FEnemyEncounterSolver::GatherCandidates()
+{
+    TArray<FAssetData> Assets;
+    IAssetRegistry::GetChecked().GetAssetsByClass(UEnemyConfiguration::StaticClass()->GetClassPathName(), Assets, true);
+    
+    int32 NumAdded = 0;
+    Candidates.Reserve(Candidates.Num() + Assets.Num());
+    for (const FAssetData& AssetData : Assets)
+    {
+        NumAdded += AddCandidate(AssetData) ? 1 : 0;
+    }
+    
+    return NumAdded;
+}
+
+bool FEnemyEncounterSolver::AddCandidate(const FAssetData& AssetData)
+{
+    // Assets saved before cost reports existed carry no tags and cannot be budgeted
+    FCandidate Candidate;
+    if (!AssetData.GetTagValue(EnemyConfigurationTags::Points, Candidate.Cost.Points))
+    {
+        return false;
+    }
+    
+    AssetData.GetTagValue(EnemyConfigurationTags::SpawnCostMs, Candidate.Cost.SpawnCostMs);
+    AssetData.GetTagValue(EnemyConfigurationTags::RuntimeCostMs, Candidate.Cost.RuntimeCostMs);
+    AssetData.GetTagValue(EnemyConfigurationTags::MemoryBytes, Candidate.Cost.MemoryBytes);
+    
+    FString TagsString;
+    if (AssetData.GetTagValue(EnemyConfigurationTags::GameplayTags, TagsString))
+    {
+        Candidate.Tags.FromExportString(TagsString);
+    }
+    
+    Candidate.Configuration = AssetData.GetSoftObjectPath();
+    Candidates.Add(MoveTemp(Candidate));
+    return true;
+}
+
+FEnemySpawnManifest FEnemyEncounterSolver::Solve(const FEnemyEncounterBudget& Budget) const
+{
+    using namespace EnemyEncounterSolver;
+    
+    FEnemySpawnManifest Manifest;
+    Manifest.Total.Points = 0.0f;
+    if (Budget.Points <= 0.0f)
+    {
+        return Manifest;
+    }
+    
+    // Candidates that pass the tag constraints, densest first; path order breaks ties so results are stable
+    TArray<int32> Order;
+    TArray<float> Density;
+    Density.SetNumZeroed(Candidates.Num());
+    for (int32 Index = 0; Index < Candidates.Num(); ++Index)
+    {
+        const FCandidate& Candidate = Candidates[Index];
+        if (Candidate.Cost.Points > 0.0f
+            && Candidate.Tags.HasAll(Budget.RequiredTags)
+            && !Candidate.Tags.HasAny(Budget.BlockedTags))
+        {
+            Density[Index] = GetDensity(Candidate.Cost, Budget);
+            Order.Add(Index);
+        }
+    }
+    
+    Order.Sort([this, &Density](int32 A, int32 B)
+    {
+        return Density[A] != Density[B] ? Density[A] > Density[B] : Candidates[A].Configuration.LexicalLess(Candidates[B].Configuration);
+    });
+    
+    FState State(Candidates.Num());
+    Fill(State, Candidates, Order, Budget);
+    
+    // Greedy stops at the first dimension to run out; trade one instance for a richer one while that helps
+    const int32 MaxPasses = FMath::Max(4, Order.Num());
+    for (int32 Pass = 0; Pass < MaxPasses; ++Pass)
+    {
+        int32 BestRemove = INDEX_NONE;
+        int32 BestAdd = INDEX_NONE;
+        float BestGain = UE_KINDA_SMALL_NUMBER;
+        
+        for (int32 RemoveIndex : Order)
+        {
+            if (State.Counts[RemoveIndex] == 0)
+            {
+                continue;
+            }
+            
+            for (int32 AddIndex : Order)
+            {
+                const float Gain = Candidates[AddIndex].Cost.Points - Candidates[RemoveIndex].Cost.Points;
+                if (AddIndex != RemoveIndex && Gain > BestGain && Fits(State, Candidates, Budget, AddIndex, RemoveIndex))
+                {
+                    BestRemove = RemoveIndex;
+                    BestAdd = AddIndex;
+                    BestGain = Gain;
+                }
+            }
+        }
+        
+        if (BestAdd == INDEX_NONE)
+        {
+            break;
+        }
+        
+        Remove(State, Candidates[BestRemove].Cost, BestRemove);
+        Add(State, Candidates[BestAdd].Cost, BestAdd);
+        Fill(State, Candidates, Order, Budget);
+    }
+    
+    for (int32 Index : Order)
+    {
+        if (State.Counts[Index] > 0)
+        {
+            FEnemySpawnManifestEntry& Entry = Manifest.Entries.AddDefaulted_GetRef();
+            Entry.Configuration = TSoftObjectPtr<UEnemyConfiguration>(Candidates[Index].Configuration);
+            Entry.Count = State.Counts[Index];
+        }
+    }
+    
+    Manifest.Entries.StableSort([](const FEnemySpawnManifestEntry& A, const FEnemySpawnManifestEntry& B) { return A.Count > B.Count; });
+    Manifest.Total = State.Total;
+    Manifest.NumEnemies = State.NumEnemies;
+    return Manifest;
+}
@@ -0,0 +1,44 @@
+#include "EnemyFacetIntern.h"
+
+namespace EnemyFacetIntern
+{
+    static TEnemyFacetInternTable<FEnemyResolvedVisuals>& GetVisualsTable()
+    {
+        static TEnemyFacetInternTable<FEnemyResolvedVisuals> Table;
+        return Table;
+    }
+
+    static TEnemyFacetInternTable<FEnemyResolvedAIConfig>& GetAIConfigTable()
+    {
+        static TEnemyFacetInternTable<FEnemyResolvedAIConfig> Table;
+        return Table;
+    }
+
+    static TEnemyFacetInternTable<FEnemyAbilityTable>& GetAbilitiesTable()
+    {
+        static TEnemyFacetInternTable<FEnemyAbilityTable> Table;
+        return Table;
+    }
+
+    FEnemyVisualsFacet Intern(FEnemyResolvedVisuals&& Visuals)
+    {
+        return GetVisualsTable().Intern(MoveTemp(Visuals));
+    }
+
+    FEnemyAIConfigFacet Intern(FEnemyResolvedAIConfig&& AIConfig)
+    {
+        return GetAIConfigTable().Intern(MoveTemp(AIConfig));
+    }
+
+    FEnemyAbilitiesFacet Intern(FEnemyAbilityTable&& Abilities)
+    {
+        return GetAbilitiesTable().Intern(MoveTemp(Abilities));
+    }
+
+    void Compact()
+    {
+        GetVisualsTable().Compact();
+        GetAIConfigTable().Compact();
+        GetAbilitiesTable().Compact();
+    }
+}
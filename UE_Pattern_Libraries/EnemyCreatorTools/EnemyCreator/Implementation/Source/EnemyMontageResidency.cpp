@@ -0,0 +1,68 @@
+#include "EnemyMontageResidency.h"
+#include "EnemyAbilityTable.h"
+#include "Animation/AnimMontage.h"
+#include "Engine/AssetManager.h"
+#include "Engine/StreamableManager.h"
+
+void FEnemyMontageResidency::Require(const TSoftObjectPtr<UAnimMontage>& Montage, double Now)
+{
+    if (Montage.IsNull())
+    {
+        return;
+    }
+    
+    FResidentMontage& Resident = Montages.FindOrAdd(Montage.ToSoftObjectPath());
+    Resident.LastRequiredTime = Now;
+    
+    // Requested ahead of use, but possibly only a cooldown's lead time ahead, so it jumps the queue
+    if (!Resident.Handle.IsValid())
+    {
+        Resident.Handle = UAssetManager::GetStreamableManager().RequestAsyncLoad(Montage.ToSoftObjectPath(), FStreamableDelegate(), FStreamableManager::AsyncLoadHighPriority);
+    }
+}
+
+void FEnemyMontageResidency::RequireAbilities(const FEnemyAbilityTable& Abilities, double Now)
+{
+    for (const FEnemyAbilityRecord& Record : Abilities.Records)
+    {
+        Require(Abilities.GetColdData(Record).AbilityMontage, Now);
+    }
+}
+
+int32 FEnemyMontageResidency::Evict(double Now, double Linger)
+{
+    int32 NumEvicted = 0;
+    for (auto It = Montages.CreateIterator(); It; ++It)
+    {
+        if (Now - It->Value.LastRequiredTime > Linger)
+        {
+            if (It->Value.Handle.IsValid())
+            {
+                It->Value.Handle->ReleaseHandle();
+            }
+            It.RemoveCurrent();
+            ++NumEvicted;
+        }
+    }
+    
+    return NumEvicted;
+}
+
+bool FEnemyMontageResidency::IsResident(const TSoftObjectPtr<UAnimMontage>& Montage) const
+{
+    const FResidentMontage* Resident = Montages.Find(Montage.ToSoftObjectPath());
+    return Resident && Resident->Handle.IsValid() && Resident->Handle->HasLoadCompleted();
+}
+
+void FEnemyMontageResidency::Reset()
+{
+    for (TPair<FSoftObjectPath, FResidentMontage>& Pair : Montages)
+    {
+        if (Pair.Value.Handle.IsValid())
+        {
+            Pair.Value.Handle->ReleaseHandle();
+        }
+    }
+    
+    Montages.Reset();
+}
@@ -0,0 +1,56 @@
+#include "EnemyPhaseMachine.h"
+#include "EnemyTemplate.h"
+
+FEnemyPhaseMachine::FEnemyPhaseMachine(ACharacter* InEnemy, const UEnemyTemplate& InTemplate, const FEnemyResolvedTemplateRef& InOpeningSnapshot)
+    : Enemy(InEnemy)
+    , Template(&InTemplate)
+    , OpeningSnapshot(InOpeningSnapshot)
+{
+}
+
+bool FEnemyPhaseMachine::Update(float DeltaTime, float HealthFraction)
+{
+    TimeInPhase += DeltaTime;
+    
+    const TArray<FEnemyResolvedPhase>& Phases = OpeningSnapshot->Phases;
+    bool bChanged = false;
+    while (Phases.IsValidIndex(PhaseIndex + 1))
+    {
+        const FEnemyResolvedPhase& NextPhase = Phases[PhaseIndex + 1];
+        const bool bHealthReached = NextPhase.HealthThreshold > 0.0f && HealthFraction <= NextPhase.HealthThreshold;
+        const bool bTimeReached = NextPhase.TimeInPreviousPhase > 0.0f && TimeInPhase >= NextPhase.TimeInPreviousPhase;
+        if (!bHealthReached && !bTimeReached)
+        {
+            break;
+        }
+        
+        ++PhaseIndex;
+        TimeInPhase = 0.0f;
+        bChanged = true;
+    }
+    
+    return bChanged;
+}
+
+const FEnemyResolvedPhase* FEnemyPhaseMachine::GetNextPhase() const
+{
+    const TArray<FEnemyResolvedPhase>& Phases = OpeningSnapshot->Phases;
+    return Phases.IsValidIndex(PhaseIndex + 1) ? &Phases[PhaseIndex + 1] : nullptr;
+}
+
+bool FEnemyPhaseMachine::IsNextPhaseNear(float HealthFraction, float HealthMargin, float TimeMargin) const
+{
+    const FEnemyResolvedPhase* NextPhase = GetNextPhase();
+    if (!NextPhase)
+    {
+        return false;
+    }
+    
+    return (NextPhase->HealthThreshold > 0.0f && HealthFraction <= NextPhase->HealthThreshold + HealthMargin)
+        || (NextPhase->TimeInPreviousPhase > 0.0f && TimeInPhase >= NextPhase->TimeInPreviousPhase - TimeMargin);
+}
+
+const FEnemyResolvedTemplateRef& FEnemyPhaseMachine::GetActiveSnapshot() const
+{
+    return PhaseIndex == INDEX_NONE ? OpeningSnapshot : OpeningSnapshot->Phases[PhaseIndex].Snapshot;
+}
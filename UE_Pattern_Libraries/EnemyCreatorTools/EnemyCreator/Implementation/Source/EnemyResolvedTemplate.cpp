@@ -0,0 +1,371 @@
+#include "EnemyResolvedTemplate.h"
+#include "EnemyTemplate.h"
+#include "EnemyFacetIntern.h"
+#include "EnemyDifficulty.h"
+#include "EnemyTypeTraits.h"
+#include "Hash/CityHash.h"
+
+#include <atomic>
+
+DEFINE_LOG_CATEGORY_STATIC(LogEnemyResolvedTemplate, Log, All);
+
+namespace EnemyResolvedTemplate
+{
+    /** Source of snapshot serials, bumped on every publish */
+    static std::atomic<uint32> NextSerial{ 1 };
+    
+    /** Set once a tier lookup has fallen back, so the warning is not repeated every frame */
+    static std::atomic<bool> bWarnedTierFallback{ false };
+}
+
+FEnemyResolvedVisuals FEnemyResolvedVisuals::FromCustomization(const FEnemyVisualCustomization& Customization)
+{
+    FEnemyResolvedVisuals Visuals;
+    Visuals.SkeletalMesh = Customization.SkeletalMesh;
+    Visuals.AnimationBlueprint = Customization.AnimationBlueprint;
+    Visuals.Scale = Customization.Scale;
+    Visuals.ColorTint = Customization.ColorTint;
+    Visuals.ScalarParameters = decltype(Visuals.ScalarParameters)::FromMap(Customization.ScalarParameters);
+    Visuals.VectorParameters = decltype(Visuals.VectorParameters)::FromMap(Customization.VectorParameters);
+    Visuals.TextureParameters = decltype(Visuals.TextureParameters)::FromMap(Customization.TextureParameters);
+    Visuals.MaterialOverrides = decltype(Visuals.MaterialOverrides)::FromMap(Customization.MaterialOverrides);
+    Visuals.LODTiers = Customization.LODTiers;
+    return Visuals;
+}
+
+bool FEnemyResolvedVisuals::operator==(const FEnemyResolvedVisuals& Other) const
+{
+    return SkeletalMesh == Other.SkeletalMesh
+        && AnimationBlueprint == Other.AnimationBlueprint
+        && Scale == Other.Scale
+        && ColorTint == Other.ColorTint
+        && ScalarParameters == Other.ScalarParameters
+        && VectorParameters == Other.VectorParameters
+        && TextureParameters == Other.TextureParameters
+        && MaterialOverrides == Other.MaterialOverrides
+        && LODTiers == Other.LODTiers;
+}
+
+uint32 GetTypeHash(const FEnemyResolvedVisuals& Visuals)
+{
+    uint32 Hash = GetTypeHash(Visuals.SkeletalMesh);
+    Hash = HashCombineFast(Hash, GetTypeHash(Visuals.AnimationBlueprint));
+    Hash = HashCombineFast(Hash, GetTypeHash(Visuals.Scale));
+    Hash = HashCombineFast(Hash, GetTypeHash(Visuals.ColorTint));
+    Hash = HashCombineFast(Hash, GetTypeHash(Visuals.ScalarParameters));
+    Hash = HashCombineFast(Hash, GetTypeHash(Visuals.VectorParameters));
+    Hash = HashCombineFast(Hash, GetTypeHash(Visuals.TextureParameters));
+    Hash = HashCombineFast(Hash, GetTypeHash(Visuals.MaterialOverrides));
+    for (const FEnemyVisualLODTier& Tier : Visuals.LODTiers)
+    {
+        Hash = HashCombineFast(Hash, HashCombineFast(GetTypeHash(Tier.MaxSignificance), GetTypeHash(Tier.Material)));
+    }
+    return Hash;
+}
+
+uint64 FEnemyResolvedVisuals::GetContentHash() const
+{
+    // Parameter maps are sorted by FName index, which differs between sessions; order by text instead
+    auto SortedByName = [](const auto& Map)
+    {
+        TArray<TPair<FString, int32>, TInlineAllocator<8>> Names;
+        for (int32 Index = 0; Index < Map.Num(); ++Index)
+        {
+            Names.Emplace(Map.GetEntries()[Index].Key.ToString(), Index);
+        }
+        Names.Sort([](const TPair<FString, int32>& A, const TPair<FString, int32>& B) { return A.Key < B.Key; });
+        return Names;
+    };
+    
+    TStringBuilder<512> Content;
+    Content << SkeletalMesh.ToString() << TEXT('|') << Scale.ToString() << TEXT('|') << ColorTint.ToString();
+    
+    for (const TPair<FString, int32>& Name : SortedByName(ScalarParameters))
+    {
+        Content << TEXT("|S:") << Name.Key << TEXT('=') << LexToString(ScalarParameters.GetEntries()[Name.Value].Value);
+    }
+    
+    for (const TPair<FString, int32>& Name : SortedByName(VectorParameters))
+    {
+        Content << TEXT("|V:") << Name.Key << TEXT('=') << VectorParameters.GetEntries()[Name.Value].Value.ToString();
+    }
+    
+    for (const TPair<FString, int32>& Name : SortedByName(TextureParameters))
+    {
+        Content << TEXT("|T:") << Name.Key << TEXT('=') << TextureParameters.GetEntries()[Name.Value].Value.ToString();
+    }
+    
+    // Slot indices already sort the same way in every session
+    for (const auto& Override : MaterialOverrides)
+    {
+        Content << TEXT("|M:") << Override.Key << TEXT('=') << Override.Value.ToString();
+    }
+    
+    const FTCHARToUTF8 Utf8(Content.ToString(), Content.Len());
+    return CityHash64(Utf8.Get(), Utf8.Length());
+}
+
+FEnemyResolvedAIConfig FEnemyResolvedAIConfig::FromConfig(const FEnemyAIConfig& Config)
+{
+    FEnemyResolvedAIConfig Resolved;
+    Resolved.BehaviorTree = Config.BehaviorTree;
+    Resolved.Blackboard = Config.Blackboard;
+    Resolved.AggressionLevel = Config.AggressionLevel;
+    Resolved.PreferredRange = Config.PreferredRange;
+    Resolved.bUseCover = Config.bUseCover;
+    Resolved.bCoordinateWithAllies = Config.bCoordinateWithAllies;
+    Resolved.BehaviorParameters = decltype(Resolved.BehaviorParameters)::FromMap(Config.BehaviorParameters);
+    Resolved.PersonalityTags = Config.PersonalityTags;
+    return Resolved;
+}
+
+bool FEnemyResolvedAIConfig::operator==(const FEnemyResolvedAIConfig& Other) const
+{
+    return BehaviorTree == Other.BehaviorTree
+        && Blackboard == Other.Blackboard
+        && AggressionLevel == Other.AggressionLevel
+        && PreferredRange == Other.PreferredRange
+        && bUseCover == Other.bUseCover
+        && bCoordinateWithAllies == Other.bCoordinateWithAllies
+        && BehaviorParameters == Other.BehaviorParameters
+        && PersonalityTags == Other.PersonalityTags;
+}
+
+const FEnemyBaseStats& FEnemyResolvedTemplate::GetTierStats(int32 Tier) const
+{
+    if (TierStats.IsValidIndex(Tier))
+    {
+        return TierStats[Tier];
+    }
+
+    if (!EnemyResolvedTemplate::bWarnedTierFallback.exchange(true, std::memory_order_relaxed))
+    {
+        UE_LOG(LogEnemyResolvedTemplate, Warning, TEXT("%s has no stats for difficulty tier %d (built for %d tiers); using the default tier. Republish templates after changing DifficultyTiers."),
+            *TemplateName.ToString(), Tier, TierStats.Num());
+    }
+    return BaseStats;
+}
+
+void FEnemyResolvedTemplate::BuildTierStats()
+{
+    const int32 NumTiers = EnemyDifficulty::GetNumTiers();
+    const int32 DefaultTier = EnemyDifficulty::GetDefaultTier();
+
+    TierStats.Reset(NumTiers);
+    for (int32 Tier = 0; Tier < NumTiers; ++Tier)
+    {
+        FEnemyBaseStats& Stats = TierStats.Add_GetRef(BaseStats);
+        const int32 Steps = Tier - DefaultTier;
+        if (Steps == 0)
+        {
+            continue;
+        }
+
+        for (const auto& Multiplier : StatScaling.DifficultyMultipliers)
+        {
+            if (float* StatValue = UEnemyTemplate::GetStatValuePtr(Stats, Multiplier.Key))
+            {
+                *StatValue *= FMath::Pow(Multiplier.Value, static_cast<float>(Steps));
+            }
+        }
+    }
+}
+
+void FEnemyResolvedTemplate::BuildPhases(FEnemyPhaseDefinitionsPtr Definitions)
+{
+    PhaseDefinitions = MoveTemp(Definitions);
+    Phases.Reset();
+    if (!PhaseDefinitions)
+    {
+        return;
+    }
+
+    // Each phase builds on the one before it, so abilities, visuals and stat multipliers carry forward
+    const FEnemyResolvedTemplate* Previous = this;
+    Phases.Reserve(PhaseDefinitions->Num());
+    for (const FEnemyPhaseDefinition& Definition : *PhaseDefinitions)
+    {
+        FEnemyVisualsFacet PhaseVisuals = Definition.bOverrideVisuals
+            ? EnemyFacetIntern::Intern(FEnemyResolvedVisuals::FromCustomization(Definition.Visuals))
+            : Previous->Visuals;
+
+        FEnemyAbilitiesFacet PhaseAbilities = Previous->Abilities;
+        if (Definition.Abilities.Num() > 0)
+        {
+            FEnemyAbilityTable PhaseTable = *Previous->Abilities;
+            for (const FEnemyAbilityDefinition& Ability : Definition.Abilities)
+            {
+                PhaseTable.AddOrReplace(Ability);
+            }
+            PhaseAbilities = EnemyFacetIntern::Intern(MoveTemp(PhaseTable));
+        }
+
+        TSharedRef<FEnemyResolvedTemplate, ESPMode::ThreadSafe> Phase = MakeShared<FEnemyResolvedTemplate, ESPMode::ThreadSafe>(PhaseVisuals, AIConfig, PhaseAbilities);
+        Phase->TemplateName = TemplateName;
+        Phase->InheritanceChain = InheritanceChain;
+        Phase->Serial = AllocateSerial();
+        Phase->EnemyType = EnemyType;
+        Phase->StatScaling = StatScaling;
+        Phase->TemplateTags = TemplateTags;
+
+        Phase->BaseStats = Previous->BaseStats;
+        for (const auto& StatMod : Definition.StatMultipliers)
+        {
+            if (float* StatValue = UEnemyTemplate::GetStatValuePtr(Phase->BaseStats, StatMod.Key))
+            {
+                *StatValue *= StatMod.Value;
+            }
+        }
+
+        // Phases only add abilities, so every trait of the previous phase still holds
+        Phase->TraitMask = Previous->TraitMask | BuildTraitMask(EnemyType, *AIConfig, *PhaseAbilities, TemplateTags);
+        Phase->BuildTierStats();
+
+        Phases.Add(FEnemyResolvedPhase{ Definition.PhaseName, Definition.HealthThreshold, Definition.TimeInPreviousPhase, Phase });
+        Previous = &Phase.Get();
+    }
+}
+
+uint32 FEnemyResolvedTemplate::AllocateSerial()
+{
+    return EnemyResolvedTemplate::NextSerial.fetch_add(1, std::memory_order_relaxed);
+}
+
+FEnemyTraitMask FEnemyResolvedTemplate::BuildTraitMask(EEnemyType Type, const FEnemyResolvedAIConfig& AIConfig, const FEnemyAbilityTable& Abilities, const FGameplayTagContainer& Tags)
+{
+    const bool bHasPassiveAbility = Abilities.Records.ContainsByPredicate([](const FEnemyAbilityRecord& Record) { return Record.IsPassive(); });
+
+    // An aura ability on an archetype that does not run auras is an ordinary ability
+    const bool bEmitsAura = EnemyTypeTraits::HasAuras(Type)
+        && Abilities.Records.ContainsByPredicate([](const FEnemyAbilityRecord& Record) { return Record.IsAura(); });
+
+    FGameplayTagContainer AllTags = Tags;
+    AllTags.AppendTags(AIConfig.PersonalityTags);
+
+    return FEnemyTraitMask::Build(Type, AIConfig.bUseCover, AIConfig.bCoordinateWithAllies, bHasPassiveAbility, bEmitsAura, AllTags);
+}
+
+FEnemyResolvedTemplateRef FEnemyResolvedTemplate::Build(const UEnemyTemplate& Template)
+{
+    check(IsInGameThread());
+
+    const TArray<UEnemyTemplate*> Chain = Template.GetInheritanceChain();
+
+    // Flatten the layered view once; this table is the hot runtime copy, everything else reads the layers
+    FEnemyAbilityTable Abilities;
+    for (const FEnemyAbilityDefinition& Ability : Template.GetAbilityView())
+    {
+        Abilities.AddOrReplace(Ability);
+    }
+
+    // Facets are interned so identical blocks across templates are stored once
+    TSharedRef<FEnemyResolvedTemplate, ESPMode::ThreadSafe> Resolved = MakeShared<FEnemyResolvedTemplate, ESPMode::ThreadSafe>(
+        EnemyFacetIntern::Intern(FEnemyResolvedVisuals::FromCustomization(Template.GetVisualCustomization())),
+        EnemyFacetIntern::Intern(FEnemyResolvedAIConfig::FromConfig(Template.GetAIConfig())),
+        EnemyFacetIntern::Intern(MoveTemp(Abilities)));
+
+    Resolved->TemplateName = Template.GetTemplateName();
+    Resolved->Serial = AllocateSerial();
+    Resolved->BaseStats = Template.GetBaseStats();
+    Resolved->StatScaling = Template.GetStatScaling();
+    Resolved->TemplateTags = Template.GetTemplateTags();
+    Resolved->EnemyType = Template.GetEnemyType();
+    Resolved->TraitMask = BuildTraitMask(Resolved->EnemyType, *Resolved->AIConfig, *Resolved->Abilities, Resolved->TemplateTags);
+    Resolved->BuildTierStats();
+
+    Resolved->InheritanceChain.Reserve(Chain.Num());
+    for (const UEnemyTemplate* Link : Chain)
+    {
+        Resolved->InheritanceChain.Add(Link->GetTemplateName());
+    }
+
+    // Phases copy the finished blocks above, so they are resolved last
+    FEnemyPhaseDefinitionsPtr PhaseDefinitions;
+    if (Template.GetPhases().Num() > 0)
+    {
+        PhaseDefinitions = MakeShared<TArray<FEnemyPhaseDefinition>, ESPMode::ThreadSafe>(Template.GetPhases());
+    }
+    Resolved->BuildPhases(MoveTemp(PhaseDefinitions));
+
+    return Resolved;
+}
+
+uint32 GetTypeHash(const FEnemyResolvedAIConfig& AIConfig)
+{
+    uint32 Hash = GetTypeHash(AIConfig.BehaviorTree);
+    Hash = HashCombineFast(Hash, GetTypeHash(AIConfig.Blackboard));
+    Hash = HashCombineFast(Hash, GetTypeHash(AIConfig.AggressionLevel));
+    Hash = HashCombineFast(Hash, GetTypeHash(AIConfig.PreferredRange));
+    Hash = HashCombineFast(Hash, (AIConfig.bUseCover ? 1u : 0u) | (AIConfig.bCoordinateWithAllies ? 2u : 0u));
+    Hash = HashCombineFast(Hash, GetTypeHash(AIConfig.BehaviorParameters));
+
+    // Tag order does not affect container equality, so combine order-independently
+    uint32 TagHash = 0;
+    for (const FGameplayTag& Tag : AIConfig.PersonalityTags)
+    {
+        TagHash += GetTypeHash(Tag);
+    }
+    return HashCombineFast(Hash, TagHash);
+}
+
+FEnemyResolvedTemplateRef FEnemyResolvedTemplate::BuildVariant(const FEnemyResolvedTemplateRef& Base, const FEnemyTemplateModification& Modification)
+{
+    check(IsInGameThread());
+
+    const bool bModifiesAbilities = Modification.ModifiedAbilities.Num() > 0;
+    if (!Modification.bOverrideAIConfig && !Modification.bOverrideVisuals && !bModifiesAbilities
+        && Modification.StatMultipliers.Num() == 0 && Modification.AdditionalTags.IsEmpty())
+    {
+        return Base;
+    }
+
+    // Only overridden blocks are converted and interned; the rest are the base's facets
+    FEnemyVisualsFacet Visuals = Modification.bOverrideVisuals
+        ? EnemyFacetIntern::Intern(FEnemyResolvedVisuals::FromCustomization(Modification.VisualModifications))
+        : Base->Visuals;
+
+    FEnemyAIConfigFacet AIConfig = Modification.bOverrideAIConfig
+        ? EnemyFacetIntern::Intern(FEnemyResolvedAIConfig::FromConfig(Modification.AIModifications))
+        : Base->AIConfig;
+
+    FEnemyAbilitiesFacet Abilities = Base->Abilities;
+    if (bModifiesAbilities)
+    {
+        // Modifications only replace abilities the template actually has
+        FEnemyAbilityTable ModifiedTable = *Base->Abilities;
+        for (const auto& AbilityMod : Modification.ModifiedAbilities)
+        {
+            if (ModifiedTable.Contains(AbilityMod.Key))
+            {
+                FEnemyAbilityDefinition Definition = AbilityMod.Value;
+                Definition.AbilityName = AbilityMod.Key;
+                ModifiedTable.AddOrReplace(Definition);
+            }
+        }
+        Abilities = EnemyFacetIntern::Intern(MoveTemp(ModifiedTable));
+    }
+
+    TSharedRef<FEnemyResolvedTemplate, ESPMode::ThreadSafe> Variant = MakeShared<FEnemyResolvedTemplate, ESPMode::ThreadSafe>(Visuals, AIConfig, Abilities);
+    Variant->TemplateName = Base->TemplateName;
+    Variant->InheritanceChain = Base->InheritanceChain;
+    Variant->Serial = AllocateSerial();
+    Variant->EnemyType = Base->EnemyType;
+    Variant->StatScaling = Base->StatScaling;
+
+    Variant->BaseStats = Base->BaseStats;
+    for (const auto& StatMod : Modification.StatMultipliers)
+    {
+        if (float* StatValue = UEnemyTemplate::GetStatValuePtr(Variant->BaseStats, StatMod.Key))
+        {
+            *StatValue *= StatMod.Value;
+        }
+    }
+
+    Variant->TemplateTags = Base->TemplateTags;
+    Variant->TemplateTags.AppendTags(Modification.AdditionalTags);
+    Variant->TraitMask = BuildTraitMask(Variant->EnemyType, *Variant->AIConfig, *Variant->Abilities, Variant->TemplateTags);
+    Variant->BuildTierStats();
+    Variant->BuildPhases(Base->PhaseDefinitions);
+
+    return Variant;
+}
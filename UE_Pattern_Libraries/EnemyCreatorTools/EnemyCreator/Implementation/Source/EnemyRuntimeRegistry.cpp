@@ -0,0 +1,527 @@
+#include "EnemyRuntimeRegistry.h"
+#include "GameFramework/Character.h"
+#include "EnemyDifficulty.h"
+#include "EnemyCreatorSettings.h"
+#include "EnemyTemplate.h"
+#include "EnemyEliteAffix.h"
+#include "AbilitySystemComponent.h"
+#include "Abilities/GameplayAbility.h"
+#include "AIController.h"
+#include "EnemyCreatorScratch.h"
+#include "EnemySpawnReplay.h"
+#include "EnemyFacetIntern.h"
+
+void UEnemyRuntimeRegistry::Initialize(FSubsystemCollectionBase& Collection)
+{
+    Super::Initialize(Collection);
+    
+    const UEnemyCreatorSettings* Settings = UEnemyCreatorSettings::Get();
+    SpatialHash.SetCellSize(Settings->SpatialCellSize, Locations);
+    HealAuraEffect = Settings->HealAuraEffect.LoadSynchronous();
+    BuffAuraEffect = Settings->BuffAuraEffect.LoadSynchronous();
+    DifficultyChangedHandle = EnemyDifficulty::OnTierChanged().AddUObject(this, &UEnemyRuntimeRegistry::HandleDifficultyTierChanged);
+    AffixChangedHandle = UEnemyEliteAffix::OnAffixChanged().AddWeakLambda(this, [this](const UEnemyEliteAffix& Affix) { EliteComposer.InvalidateAffix(Affix); });
+}
+
+void UEnemyRuntimeRegistry::Deinitialize()
+{
+    EnemyDifficulty::OnTierChanged().Remove(DifficultyChangedHandle);
+    DifficultyChangedHandle.Reset();
+    UEnemyEliteAffix::OnAffixChanged().Remove(AffixChangedHandle);
+    AffixChangedHandle.Reset();
+    
+    Actors.Empty();
+    Templates.Empty();
+    TraitMasks.Empty();
+    Locations.Empty();
+    Stats.Empty();
+    AbilitySystems.Empty();
+    AuraStates.Empty();
+    SlotByActor.Empty();
+    SpatialHash.Reset();
+    PhaseMachines.Empty();
+    EffectSpecPool.Reset();
+    EliteComposer.Reset();
+    MontageResidency.Reset();
+    StatsChanged.Clear();
+    
+    // The world's snapshots were just released, leaving their facets dead in the intern tables
+    EnemyFacetIntern::Compact();
+    
+    Super::Deinitialize();
+}
+
+void UEnemyRuntimeRegistry::AddReferencedObjects(UObject* InThis, FReferenceCollector& Collector)
+{
+    // Pooled specs live outside any UPROPERTY
+    CastChecked<UEnemyRuntimeRegistry>(InThis)->EffectSpecPool.AddReferencedObjects(Collector);
+    
+    Super::AddReferencedObjects(InThis, Collector);
+}
+
+bool UEnemyRuntimeRegistry::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+    return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+TStatId UEnemyRuntimeRegistry::GetStatId() const
+{
+    RETURN_QUICK_DECLARE_CYCLE_STAT(UEnemyRuntimeRegistry, STATGROUP_Tickables);
+}
+
+void UEnemyRuntimeRegistry::Tick(float DeltaTime)
+{
+    EnemySpawnReplay::RecordFrame(DeltaTime);
+    
+    // Walk backwards so swap-removal never skips a slot
+    for (int32 Slot = Actors.Num() - 1; Slot >= 0; --Slot)
+    {
+        if (const ACharacter* Enemy = Actors[Slot].Get())
+        {
+            Locations[Slot] = Enemy->GetActorLocation();
+            SpatialHash.Update(Slot, Locations[Slot]);
+        }
+        else
+        {
+            RemoveAtSlot(Slot);
+        }
+    }
+    
+    TickPhaseMachines(DeltaTime);
+    TickAuras(DeltaTime);
+    TickMontageResidency(DeltaTime);
+}
+
+void UEnemyRuntimeRegistry::StartPhaseMachine(ACharacter* Enemy, const UEnemyTemplate& Template, const FEnemyResolvedTemplateRef& OpeningSnapshot)
+{
+    PhaseMachines.RemoveAllSwap([Enemy](const FEnemyPhaseMachine& Machine) { return Machine.Enemy == Enemy; });
+    
+    if (Enemy && OpeningSnapshot->Phases.Num() > 0)
+    {
+        PhaseMachines.Emplace(Enemy, Template, OpeningSnapshot);
+    }
+}
+
+void UEnemyRuntimeRegistry::TickPhaseMachines(float DeltaTime)
+{
+    const UEnemyCreatorSettings* Settings = UEnemyCreatorSettings::Get();
+    const FGameplayAttribute& HealthAttribute = Settings->HealthAttribute;
+    const double Now = GetWorld()->GetTimeSeconds();
+    
+    for (int32 Index = PhaseMachines.Num() - 1; Index >= 0; --Index)
+    {
+        FEnemyPhaseMachine& Machine = PhaseMachines[Index];
+        ACharacter* Enemy = Machine.Enemy.Get();
+        const UEnemyTemplate* Template = Machine.Template.Get();
+        const int32* Slot = Enemy ? SlotByActor.Find(Enemy) : nullptr;
+        if (!Slot || !Template || Machine.IsInFinalPhase())
+        {
+            PhaseMachines.RemoveAtSwap(Index, 1, false);
+            continue;
+        }
+        
+        float HealthFraction = 1.0f;
+        const float MaxHealth = Stats[*Slot].Health;
+        if (HealthAttribute.IsValid() && MaxHealth > 0.0f)
+        {
+            if (const UAbilitySystemComponent* AbilitySystem = AbilitySystems[*Slot].Get())
+            {
+                HealthFraction = AbilitySystem->GetNumericAttribute(HealthAttribute) / MaxHealth;
+            }
+        }
+        
+        // Transitions swap to a precomputed snapshot and apply only the facets that differ
+        const FEnemyResolvedTemplateRef PreviousSnapshot = Machine.GetActiveSnapshot();
+        if (Machine.Update(DeltaTime, HealthFraction))
+        {
+            const FEnemyResolvedTemplateRef NextSnapshot = Machine.GetActiveSnapshot();
+            Template->ApplyTransition(Enemy, *PreviousSnapshot, *NextSnapshot);
+            RegisterEnemy(Enemy, NextSnapshot);
+        }
+        
+        // Load the coming phase's montages while it approaches, so entering it never waits on a load
+        if (Machine.IsNextPhaseNear(HealthFraction, Settings->PhasePrefetchHealthMargin, Settings->MontagePrefetchLeadTime))
+        {
+            MontageResidency.RequireAbilities(*Machine.GetNextPhase()->Snapshot->Abilities, Now);
+        }
+    }
+}
+
+void UEnemyRuntimeRegistry::TickMontageResidency(float DeltaTime)
+{
+    const UEnemyCreatorSettings* Settings = UEnemyCreatorSettings::Get();
+    MontageResidencyTime += DeltaTime;
+    if (MontageResidencyTime < Settings->MontageResidencyInterval)
+    {
+        return;
+    }
+    MontageResidencyTime = 0.0f;
+    
+    const double Now = GetWorld()->GetTimeSeconds();
+    for (int32 Slot = 0; Slot < Actors.Num(); ++Slot)
+    {
+        // Intent: an enemy without a focus target is not about to use anything
+        const ACharacter* Enemy = Actors[Slot].Get();
+        const AAIController* Controller = Enemy ? Cast<AAIController>(Enemy->GetController()) : nullptr;
+        const AActor* Target = Controller ? Controller->GetFocusActor() : nullptr;
+        if (!Target)
+        {
+            continue;
+        }
+        
+        const float TargetDistance = FVector::Dist(Locations[Slot], Target->GetActorLocation());
+        UAbilitySystemComponent* AbilitySystem = AbilitySystems[Slot].Get();
+        const FEnemyAbilityTable& Abilities = *Templates[Slot]->Abilities;
+        
+        for (const FEnemyAbilityRecord& Record : Abilities.Records)
+        {
+            const FEnemyAbilityColdData& ColdData = Abilities.GetColdData(Record);
+            if (ColdData.AbilityMontage.IsNull() || TargetDistance > Record.Range + Settings->MontagePrefetchDistance)
+            {
+                continue;
+            }
+            
+            // Readiness: the cooldown is read from the ability system only for abilities that pass the cheap checks
+            const FGameplayAbilitySpec* Spec = AbilitySystem && ColdData.AbilityClass.Get() ? AbilitySystem->FindAbilitySpecFromClass(ColdData.AbilityClass.Get()) : nullptr;
+            const float CooldownRemaining = Spec && Spec->Ability ? Spec->Ability->GetCooldownTimeRemaining(AbilitySystem->AbilityActorInfo.Get()) : 0.0f;
+            if (CooldownRemaining <= Settings->MontagePrefetchLeadTime)
+            {
+                MontageResidency.Require(ColdData.AbilityMontage, Now);
+            }
+        }
+    }
+    
+    MontageResidency.Evict(Now, Settings->MontageEvictionDelay);
+}
+
+void UEnemyRuntimeRegistry::TickAuras(float DeltaTime)
+{
+    const UEnemyCreatorSettings* Settings = UEnemyCreatorSettings::Get();
+    AuraPulseTime += DeltaTime;
+    if (AuraPulseTime < Settings->AuraPulseInterval)
+    {
+        return;
+    }
+    const float PulseElapsed = AuraPulseTime;
+    AuraPulseTime = 0.0f;
+    
+    TArray<int32> Sources;
+    EnemyTraitMask::Filter(TraitMasks, FEnemyTraitMask::ForBit(EnemyTraitBits::EmitsAura), FEnemyTraitMask(), Sources);
+    
+    // With no sources left, a pass is still needed once to lift any buffs that are still applied
+    const bool bAnyBuffApplied = AuraStates.ContainsByPredicate([](const FAuraState& State) { return State.BuffMagnitude != 0.0f; });
+    if (Sources.Num() == 0 && !bAnyBuffApplied)
+    {
+        return;
+    }
+    
+    FEnemyCreatorScratchScope Scratch;
+    
+    TEnemyScratchArray<float> HealTotals;
+    TEnemyScratchArray<float> BuffTotals;
+    HealTotals.SetNumZeroed(Actors.Num());
+    BuffTotals.SetNumZeroed(Actors.Num());
+    
+    // Gather: sum every aura into its recipients' totals without touching an ability system
+    for (const int32 SourceSlot : Sources)
+    {
+        const auto& Records = Templates[SourceSlot]->Abilities->Records;
+        TArray<float, TInlineAllocator<4>>& HealCooldowns = AuraStates[SourceSlot].HealCooldowns;
+        HealCooldowns.SetNumZeroed(Records.Num(), false);
+        
+        for (int32 RecordIndex = 0; RecordIndex < Records.Num(); ++RecordIndex)
+        {
+            const FEnemyAbilityRecord& Record = Records[RecordIndex];
+            if (!Record.IsAura())
+            {
+                continue;
+            }
+            
+            // Heals land once per cooldown, the same rate the granted ability could be used at
+            if (Record.AuraType == EEnemyAuraType::Heal)
+            {
+                float& Remaining = HealCooldowns[RecordIndex];
+                Remaining -= PulseElapsed;
+                if (Remaining > 0.0f)
+                {
+                    continue;
+                }
+                Remaining = Record.CooldownTime;
+            }
+            
+            TEnemyScratchArray<float>& Totals = Record.AuraType == EEnemyAuraType::Heal ? HealTotals : BuffTotals;
+            SpatialHash.ForEachInRadius(Locations[SourceSlot], Record.Range, Locations, [&Totals, SourceSlot, Magnitude = Record.AuraMagnitude](int32 Slot)
+            {
+                if (Slot != SourceSlot)
+                {
+                    Totals[Slot] += Magnitude;
+                }
+            });
+        }
+    }
+    
+    // Apply: one heal per recipient, and a buff swap only where the combined buff changed
+    TEnemyScratchArray<UAbilitySystemComponent*> HealTargets;
+    TEnemyScratchArray<float> HealMagnitudes;
+    TEnemyScratchArray<UAbilitySystemComponent*> BuffTargets;
+    TEnemyScratchArray<float> BuffMagnitudes;
+    TEnemyScratchArray<int32> BuffSlots;
+    
+    for (int32 Slot = 0; Slot < Actors.Num(); ++Slot)
+    {
+        UAbilitySystemComponent* AbilitySystem = AbilitySystems[Slot].Get();
+        if (!AbilitySystem)
+        {
+            continue;
+        }
+        
+        if (HealTotals[Slot] > 0.0f)
+        {
+            HealTargets.Add(AbilitySystem);
+            HealMagnitudes.Add(HealTotals[Slot]);
+        }
+        
+        FAuraState& State = AuraStates[Slot];
+        if (FMath::IsNearlyEqual(BuffTotals[Slot], State.BuffMagnitude))
+        {
+            continue;
+        }
+        
+        if (State.BuffHandle.IsValid())
+        {
+            AbilitySystem->RemoveActiveGameplayEffect(State.BuffHandle);
+            State.BuffHandle.Invalidate();
+        }
+        State.BuffMagnitude = BuffTotals[Slot];
+        
+        if (BuffTotals[Slot] > 0.0f)
+        {
+            BuffTargets.Add(AbilitySystem);
+            BuffMagnitudes.Add(BuffTotals[Slot]);
+            BuffSlots.Add(Slot);
+        }
+    }
+    
+    if (HealAuraEffect && HealTargets.Num() > 0)
+    {
+        EffectSpecPool.ApplyToTargetsWithMagnitudes(HealTargets, HealMagnitudes, Settings->AuraMagnitudeTag, HealAuraEffect, 1.0f, this);
+    }
+    
+    if (BuffAuraEffect && BuffTargets.Num() > 0)
+    {
+        TEnemyScratchArray<FActiveGameplayEffectHandle> BuffHandles;
+        BuffHandles.SetNum(BuffTargets.Num());
+        EffectSpecPool.ApplyToTargetsWithMagnitudes(BuffTargets, BuffMagnitudes, Settings->AuraMagnitudeTag, BuffAuraEffect, 1.0f, this, BuffHandles);
+        
+        for (int32 Index = 0; Index < BuffSlots.Num(); ++Index)
+        {
+            AuraStates[BuffSlots[Index]].BuffHandle = BuffHandles[Index];
+        }
+    }
+}
+
+void UEnemyRuntimeRegistry::RegisterEnemy(ACharacter* Enemy, const FEnemyResolvedTemplateRef& Template)
+{
+    if (!Enemy)
+    {
+        return;
+    }
+    
+    if (const int32* ExistingSlot = SlotByActor.Find(Enemy))
+    {
+        const int32 Slot = *ExistingSlot;
+        
+        // Heal cooldowns are indexed by the old template's records. The buff stays: it is what this enemy receives
+        if (Templates[Slot].Get() != &Template.Get())
+        {
+            AuraStates[Slot].HealCooldowns.Reset();
+        }
+        Templates[Slot] = Template;
+        TraitMasks[Slot] = Template->TraitMask.Bits;
+        
+        // Phase transitions and reconfigures land here, so stat copies elsewhere hear about it like a tier switch
+        const FEnemyBaseStats& NewStats = Template->GetTierStats(EnemyDifficulty::GetActiveTier());
+        if (!FEnemyBaseStats::StaticStruct()->CompareScriptStruct(&Stats[Slot], &NewStats, PPF_None))
+        {
+            Stats[Slot] = NewStats;
+            StatsChanged.Broadcast(Enemy, Stats[Slot]);
+        }
+        return;
+    }
+    
+    // Spawns usually precede a fight; holding the opening montages for one eviction delay covers the first use
+    MontageResidency.RequireAbilities(*Template->Abilities, GetWorld()->GetTimeSeconds());
+    
+    const int32 Slot = Actors.Add(Enemy);
+    Templates.Add(Template);
+    TraitMasks.Add(Template->TraitMask.Bits);
+    Locations.Add(Enemy->GetActorLocation());
+    Stats.Add(Template->GetTierStats(EnemyDifficulty::GetActiveTier()));
+    AbilitySystems.Add(Enemy->FindComponentByClass<UAbilitySystemComponent>());
+    AuraStates.AddDefaulted();
+    SpatialHash.Add(Slot, Locations[Slot]);
+    SlotByActor.Add(Enemy, Slot);
+}
+
+void UEnemyRuntimeRegistry::UnregisterEnemy(ACharacter* Enemy)
+{
+    if (const int32* Slot = SlotByActor.Find(Enemy))
+    {
+        RemoveAtSlot(*Slot);
+    }
+}
+
+void UEnemyRuntimeRegistry::RemoveAtSlot(int32 Slot)
+{
+    const int32 LastSlot = Actors.Num() - 1;
+    
+    // The aura buff is only ever lifted by a pulse, which no longer visits this enemy
+    const FAuraState& State = AuraStates[Slot];
+    UAbilitySystemComponent* AbilitySystem = AbilitySystems[Slot].Get();
+    if (AbilitySystem && State.BuffHandle.IsValid())
+    {
+        AbilitySystem->RemoveActiveGameplayEffect(State.BuffHandle);
+    }
+    
+    SlotByActor.Remove(Actors[Slot]);
+    if (Slot != LastSlot)
+    {
+        SlotByActor.Add(Actors[LastSlot], Slot);
+    }
+    
+    SpatialHash.RemoveAtSwap(Slot);
+    Actors.RemoveAtSwap(Slot, 1, false);
+    Templates.RemoveAtSwap(Slot, 1, false);
+    TraitMasks.RemoveAtSwap(Slot, 1, false);
+    Locations.RemoveAtSwap(Slot, 1, false);
+    Stats.RemoveAtSwap(Slot, 1, false);
+    AbilitySystems.RemoveAtSwap(Slot, 1, false);
+    AuraStates.RemoveAtSwap(Slot, 1, false);
+}
+
+void UEnemyRuntimeRegistry::HandleDifficultyTierChanged(int32 NewTier)
+{
+    // Tier tables are precomputed per snapshot, so the pass is a straight copy per enemy
+    for (int32 Slot = 0; Slot < Stats.Num(); ++Slot)
+    {
+        Stats[Slot] = Templates[Slot]->GetTierStats(NewTier);
+    }
+    
+    if (!StatsChanged.IsBound())
+    {
+        return;
+    }
+    
+    // Listeners may unregister enemies, so notify from a copy of the slots
+    TArray<TWeakObjectPtr<ACharacter>> Changed(Actors);
+    for (const TWeakObjectPtr<ACharacter>& Enemy : Changed)
+    {
+        if (const FEnemyBaseStats* EnemyStats = FindStats(Enemy.Get()))
+        {
+            StatsChanged.Broadcast(Enemy.Get(), *EnemyStats);
+        }
+    }
+}
+
+const FEnemyBaseStats* UEnemyRuntimeRegistry::FindStats(ACharacter* Enemy) const
+{
+    const int32* Slot = SlotByActor.Find(Enemy);
+    return Slot ? &Stats[*Slot] : nullptr;
+}
+
+FEnemyResolvedTemplatePtr UEnemyRuntimeRegistry::FindTemplate(ACharacter* Enemy) const
+{
+    const int32* Slot = SlotByActor.Find(Enemy);
+    return Slot ? Templates[*Slot] : nullptr;
+}
+
+int32 UEnemyRuntimeRegistry::SelectAbility(ACharacter* Enemy, float Distance, TArrayView<const float> CooldownRemaining, float AvailableResource) const
+{
+    const int32* Slot = SlotByActor.Find(Enemy);
+    if (!Slot)
+    {
+        return INDEX_NONE;
+    }
+    
+    const int32 SelectedAbility = Templates[*Slot]->Abilities->SelectAbilityInRange(Distance, CooldownRemaining, AvailableResource);
+    if (EnemySpawnReplay::IsRecording())
+    {
+        EnemySpawnReplay::RecordAbilityDecision(*Enemy, Distance, CooldownRemaining, AvailableResource, SelectedAbility);
+    }
+    
+    return SelectedAbility;
+}
+
+void UEnemyRuntimeRegistry::QueryByTraits(FEnemyTraitMask Required, FEnemyTraitMask Excluded, TArray<ACharacter*>& OutEnemies) const
+{
+    TArray<int32> Matches;
+    EnemyTraitMask::Filter(TraitMasks, Required, Excluded, Matches);
+    
+    OutEnemies.Reset(Matches.Num());
+    for (const int32 Slot : Matches)
+    {
+        if (ACharacter* Enemy = Actors[Slot].Get())
+        {
+            OutEnemies.Add(Enemy);
+        }
+    }
+}
+
+void UEnemyRuntimeRegistry::QueryByTraitsInRadius(const FVector& Center, float Radius, FEnemyTraitMask Required, FEnemyTraitMask Excluded, TArray<ACharacter*>& OutEnemies) const
+{
+    OutEnemies.Reset();
+    SpatialHash.ForEachInRadius(Center, Radius, Locations, [this, Required, Excluded, &OutEnemies](int32 Slot)
+    {
+        if (FEnemyTraitMask(TraitMasks[Slot]).Matches(Required, Excluded))
+        {
+            if (ACharacter* Enemy = Actors[Slot].Get())
+            {
+                OutEnemies.Add(Enemy);
+            }
+        }
+    });
+}
+
+void UEnemyRuntimeRegistry::QueryAbilityRange(FName AbilityName, FEnemyTraitMask Required, FEnemyTraitMask Excluded, FEnemyRangeQueryResult& OutResult) const
+{
+    OutResult.Reset();
+    OutResult.Offsets.Add(0);
+    
+    for (int32 Slot = 0; Slot < Templates.Num(); ++Slot)
+    {
+        // Range comes from each source's own table, so variants with a longer heal reach further
+        const FEnemyAbilityTable& Abilities = *Templates[Slot]->Abilities;
+        const int32 RecordIndex = Abilities.Find(AbilityName);
+        if (RecordIndex != INDEX_NONE)
+        {
+            AppendNeighbors(Slot, Abilities.Records[RecordIndex].Range, Required, Excluded, OutResult);
+        }
+    }
+}
+
+void UEnemyRuntimeRegistry::QueryPreferredRange(FEnemyTraitMask SourceRequired, FEnemyTraitMask Required, FEnemyTraitMask Excluded, FEnemyRangeQueryResult& OutResult) const
+{
+    OutResult.Reset();
+    OutResult.Offsets.Add(0);
+    
+    TArray<int32> SourceSlots;
+    EnemyTraitMask::Filter(TraitMasks, SourceRequired, FEnemyTraitMask(), SourceSlots);
+    for (const int32 Slot : SourceSlots)
+    {
+        AppendNeighbors(Slot, Templates[Slot]->AIConfig->PreferredRange, Required, Excluded, OutResult);
+    }
+}
+
+void UEnemyRuntimeRegistry::AppendNeighbors(int32 SourceSlot, float Radius, FEnemyTraitMask Required, FEnemyTraitMask Excluded, FEnemyRangeQueryResult& OutResult) const
+{
+    SpatialHash.ForEachInRadius(Locations[SourceSlot], Radius, Locations, [this, SourceSlot, Required, Excluded, &OutResult](int32 Slot)
+    {
+        if (Slot != SourceSlot && FEnemyTraitMask(TraitMasks[Slot]).Matches(Required, Excluded))
+        {
+            OutResult.Neighbors.Add(Slot);
+        }
+    });
+    
+    OutResult.Sources.Add(SourceSlot);
+    OutResult.Offsets.Add(OutResult.Neighbors.Num());
+}
@@ -0,0 +1,91 @@
+#include "EnemySpatialHash.h"
+
+FEnemySpatialHash::FEnemySpatialHash(float InCellSize)
+    : CellSize(FMath::Max(InCellSize, 1.0f))
+    , InvCellSize(1.0f / CellSize)
+{
+}
+
+void FEnemySpatialHash::SetCellSize(float InCellSize, TConstArrayView<FVector> Locations)
+{
+    check(Locations.Num() == SlotCells.Num());
+    
+    CellSize = FMath::Max(InCellSize, 1.0f);
+    InvCellSize = 1.0f / CellSize;
+    
+    Reset();
+    for (int32 Slot = 0; Slot < Locations.Num(); ++Slot)
+    {
+        Add(Slot, Locations[Slot]);
+    }
+}
+
+void FEnemySpatialHash::Add(int32 Slot, const FVector& Location)
+{
+    check(Slot == SlotCells.Num());
+    
+    SlotCells.AddUninitialized();
+    SlotIndexInCell.AddUninitialized();
+    LinkSlot(Slot, GetCell(Location));
+}
+
+void FEnemySpatialHash::Update(int32 Slot, const FVector& Location)
+{
+    const FIntPoint Cell = GetCell(Location);
+    if (Cell != SlotCells[Slot])
+    {
+        UnlinkSlot(Slot);
+        LinkSlot(Slot, Cell);
+    }
+}
+
+void FEnemySpatialHash::RemoveAtSwap(int32 Slot)
+{
+    const int32 LastSlot = SlotCells.Num() - 1;
+    UnlinkSlot(Slot);
+    
+    // Renumber the last slot in place; its cell list entry keeps its position
+    if (Slot != LastSlot)
+    {
+        const FIntPoint LastCell = SlotCells[LastSlot];
+        const int32 LastIndexInCell = SlotIndexInCell[LastSlot];
+        Cells.FindChecked(LastCell)[LastIndexInCell] = Slot;
+        SlotCells[Slot] = LastCell;
+        SlotIndexInCell[Slot] = LastIndexInCell;
+    }
+    
+    SlotCells.RemoveAt(LastSlot, 1, false);
+    SlotIndexInCell.RemoveAt(LastSlot, 1, false);
+}
+
+void FEnemySpatialHash::Reset()
+{
+    Cells.Reset();
+    SlotCells.Reset();
+    SlotIndexInCell.Reset();
+}
+
+void FEnemySpatialHash::LinkSlot(int32 Slot, const FIntPoint& Cell)
+{
+    FCellSlots& CellSlots = Cells.FindOrAdd(Cell);
+    SlotCells[Slot] = Cell;
+    SlotIndexInCell[Slot] = CellSlots.Add(Slot);
+}
+
+void FEnemySpatialHash::UnlinkSlot(int32 Slot)
+{
+    const FIntPoint Cell = SlotCells[Slot];
+    FCellSlots& CellSlots = Cells.FindChecked(Cell);
+    const int32 IndexInCell = SlotIndexInCell[Slot];
+    
+    CellSlots.RemoveAtSwap(IndexInCell, 1, false);
+    if (CellSlots.IsValidIndex(IndexInCell))
+    {
+        SlotIndexInCell[CellSlots[IndexInCell]] = IndexInCell;
+    }
+    
+    if (CellSlots.Num() == 0)
+    {
+        Cells.Remove(Cell);
+    }
+}
@@ -0,0 +1,295 @@
+#include "EnemySpawnReplay.h"
+#include "EnemyCreatorTypes.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/CoreDelegates.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogEnemyReplay, Log, All);
+
+namespace EnemySpawnReplay
+{
+    /** File magic and layout version. Bump the version whenever the record layout changes */
+    static constexpr uint32 LogMagic = 0x4C525345;
+    static constexpr uint32 LogVersion = 1;
+    
+    /** Upper bound on per-decision cooldown entries, so a corrupt log cannot request a huge allocation */
+    static constexpr uint32 MaxCooldownEntries = 256;
+    
+    /**
+     * Serialize an object path as an index into the paths seen so far
+     * An index one past the end introduces a new path, written in full this once.
+     * @param PathIndices   Lookup for the paths already written; required when saving, unused when loading
+     */
+    static void SerializePath(FArchive& Ar, FSoftObjectPath& Path, TArray<FSoftObjectPath>& Paths, TMap<FSoftObjectPath, uint32>* PathIndices)
+    {
+        uint32 Index = 0;
+        if (Ar.IsSaving())
+        {
+            const uint32* Existing = PathIndices->Find(Path);
+            Index = Existing ? *Existing : static_cast<uint32>(Paths.Num());
+        }
+        Ar.SerializeIntPacked(Index);
+        
+        if (Index == static_cast<uint32>(Paths.Num()))
+        {
+            FString PathString = Ar.IsSaving() ? Path.ToString() : FString();
+            Ar << PathString;
+            if (Ar.IsLoading())
+            {
+                Path = FSoftObjectPath(PathString);
+            }
+            else
+            {
+                PathIndices->Add(Path, Index);
+            }
+            Paths.Add(Path);
+        }
+        else if (Ar.IsLoading())
+        {
+            if (Paths.IsValidIndex(Index))
+            {
+                Path = Paths[Index];
+            }
+            else
+            {
+                Ar.SetError();
+            }
+        }
+    }
+    
+    static void SerializeEnemyId(FArchive& Ar, int32& EnemyId)
+    {
+        uint32 PackedId = static_cast<uint32>(EnemyId);
+        Ar.SerializeIntPacked(PackedId);
+        EnemyId = static_cast<int32>(PackedId);
+    }
+    
+    /** Read or write one record. The same layout code runs in both directions so they cannot drift */
+    static void SerializeRecord(FArchive& Ar, FEnemyReplayRecord& Record, TArray<FSoftObjectPath>& Paths, TMap<FSoftObjectPath, uint32>* PathIndices)
+    {
+        uint8 Type = static_cast<uint8>(Record.Type);
+        Ar << Type;
+        Record.Type = static_cast<EEnemyReplayRecordType>(Type);
+        
+        switch (Record.Type)
+        {
+        case EEnemyReplayRecordType::Frame:
+            Ar << Record.DeltaTime;
+            break;
+        
+        case EEnemyReplayRecordType::Spawn:
+            SerializePath(Ar, Record.Configuration, Paths, PathIndices);
+            SerializePath(Ar, Record.EnemyClass, Paths, PathIndices);
+            SerializeEnemyId(Ar, Record.EnemyId);
+            Ar << Record.Location << Record.Yaw << Record.Seed;
+            break;
+        
+        case EEnemyReplayRecordType::AbilityDecision:
+        {
+            SerializeEnemyId(Ar, Record.EnemyId);
+            Ar << Record.Distance << Record.AvailableResource;
+            
+            uint32 NumCooldowns = static_cast<uint32>(Record.CooldownRemaining.Num());
+            Ar.SerializeIntPacked(NumCooldowns);
+            if (NumCooldowns > MaxCooldownEntries)
+            {
+                Ar.SetError();
+                return;
+            }
+            Record.CooldownRemaining.SetNumUninitialized(NumCooldowns);
+            for (float& Cooldown : Record.CooldownRemaining)
+            {
+                Ar << Cooldown;
+            }
+            
+            // Stored one higher so INDEX_NONE packs into a single byte
+            uint32 PackedSelection = static_cast<uint32>(Record.SelectedAbility + 1);
+            Ar.SerializeIntPacked(PackedSelection);
+            Record.SelectedAbility = static_cast<int32>(PackedSelection) - 1;
+            break;
+        }
+        
+        default:
+            break;
+        }
+    }
+    
+    /** A recording in progress, buffered in memory until it stops */
+    struct FRecording
+    {
+        explicit FRecording(const FString& InFilename)
+            : Filename(InFilename)
+            , Writer(Bytes)
+        {
+        }
+        
+        FString Filename;
+        TArray<uint8> Bytes;
+        FMemoryWriter Writer;
+        TArray<FSoftObjectPath> Paths;
+        TMap<FSoftObjectPath, uint32> PathIndices;
+        
+        /** Enemy ids assigned in spawn order */
+        TMap<TObjectKey<AActor>, int32> EnemyIds;
+        
+        void Write(FEnemyReplayRecord& Record)
+        {
+            SerializeRecord(Writer, Record, Paths, &PathIndices);
+        }
+    };
+    
+    static TUniquePtr<FRecording> ActiveRecording;
+    
+    void StartRecording(const FString& Filename)
+    {
+        check(IsInGameThread());
+        
+        StopRecording();
+        
+        // A playtest that quits without stopping still writes its log
+        static FDelegateHandle PreExitHandle = FCoreDelegates::OnPreExit.AddStatic([]() { StopRecording(); });
+        
+        ActiveRecording = MakeUnique<FRecording>(Filename);
+        uint32 Magic = LogMagic;
+        uint32 Version = LogVersion;
+        ActiveRecording->Writer << Magic << Version;
+        
+        UE_LOG(LogEnemyReplay, Log, TEXT("Recording enemy spawns to %s"), *Filename);
+    }
+    
+    bool StopRecording()
+    {
+        if (!ActiveRecording)
+        {
+            return false;
+        }
+        
+        FEnemyReplayRecord EndRecord;
+        EndRecord.Type = EEnemyReplayRecordType::End;
+        ActiveRecording->Write(EndRecord);
+        
+        const TUniquePtr<FRecording> Recording = MoveTemp(ActiveRecording);
+        const bool bSaved = FFileHelper::SaveArrayToFile(Recording->Bytes, *Recording->Filename);
+        UE_LOG(LogEnemyReplay, Log, TEXT("%s enemy replay %s (%d enemies, %d bytes)"), bSaved ? TEXT("Wrote") : TEXT("Failed to write"),
+            *Recording->Filename, Recording->EnemyIds.Num(), Recording->Bytes.Num());
+        return bSaved;
+    }
+    
+    bool IsRecording()
+    {
+        return ActiveRecording.IsValid();
+    }
+    
+    FString GetReplayFilename(const FString& Name)
+    {
+        return FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("EnemyReplays"), Name + TEXT(".enemyreplay"));
+    }
+    
+    void RecordFrame(float DeltaTime)
+    {
+        if (ActiveRecording)
+        {
+            FEnemyReplayRecord Record;
+            Record.Type = EEnemyReplayRecordType::Frame;
+            Record.DeltaTime = DeltaTime;
+            ActiveRecording->Write(Record);
+        }
+    }
+    
+    void RecordSpawn(const UEnemyConfiguration& Configuration, const AActor& Enemy)
+    {
+        if (!ActiveRecording)
+        {
+            return;
+        }
+        
+        // Reconfiguring a known enemy keeps its id, so replay applies to the same actor instead of spawning
+        const int32* ExistingId = ActiveRecording->EnemyIds.Find(&Enemy);
+        const int32 EnemyId = ExistingId ? *ExistingId : ActiveRecording->EnemyIds.Add(&Enemy, ActiveRecording->EnemyIds.Num());
+        
+        FEnemyReplayRecord Record;
+        Record.Type = EEnemyReplayRecordType::Spawn;
+        Record.Configuration = FSoftObjectPath(&Configuration);
+        Record.EnemyClass = FSoftObjectPath(Enemy.GetClass());
+        Record.EnemyId = EnemyId;
+        Record.Location = FVector3f(Enemy.GetActorLocation());
+        Record.Yaw = static_cast<float>(Enemy.GetActorRotation().Yaw);
+        Record.Seed = FMath::GetRandSeed();
+        ActiveRecording->Write(Record);
+    }
+    
+    void RecordAbilityDecision(const AActor& Enemy, float Distance, TArrayView<const float> CooldownRemaining, float AvailableResource, int32 SelectedAbility)
+    {
+        // Enemies not spawned through a configuration cannot be reproduced, so their decisions are not either
+        const int32* EnemyId = ActiveRecording ? ActiveRecording->EnemyIds.Find(&Enemy) : nullptr;
+        if (!EnemyId)
+        {
+            return;
+        }
+        
+        FEnemyReplayRecord Record;
+        Record.Type = EEnemyReplayRecordType::AbilityDecision;
+        Record.EnemyId = *EnemyId;
+        Record.Distance = Distance;
+        Record.AvailableResource = AvailableResource;
+        Record.CooldownRemaining.Append(CooldownRemaining.GetData(), CooldownRemaining.Num());
+        Record.SelectedAbility = SelectedAbility;
+        ActiveRecording->Write(Record);
+    }
+    
+    static FAutoConsoleCommand RecordCommand(
+        TEXT("Enemy.Replay.Record"),
+        TEXT("Record enemy spawns and AI decisions to Saved/EnemyReplays/<Name>.enemyreplay. Usage: Enemy.Replay.Record [Name]"),
+        FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+        {
+            StartRecording(GetReplayFilename(Args.Num() > 0 ? Args[0] : FDateTime::Now().ToString()));
+        }));
+    
+    static FAutoConsoleCommand StopCommand(
+        TEXT("Enemy.Replay.Stop"),
+        TEXT("Stop recording enemy spawns and write the log"),
+        FConsoleCommandDelegate::CreateLambda([]()
+        {
+            StopRecording();
+        }));
+}
+
+FEnemySpawnReplayReader::FEnemySpawnReplayReader() = default;
+
+FEnemySpawnReplayReader::~FEnemySpawnReplayReader() = default;
+
+bool FEnemySpawnReplayReader::Open(const FString& Filename)
+{
+    Reader.Reset();
+    Paths.Reset();
+    if (!FFileHelper::LoadFileToArray(Bytes, *Filename))
+    {
+        return false;
+    }
+    
+    Reader = MakeUnique<FMemoryReader>(Bytes);
+    uint32 Magic = 0;
+    uint32 Version = 0;
+    *Reader << Magic << Version;
+    if (Reader->IsError() || Magic != EnemySpawnReplay::LogMagic || Version != EnemySpawnReplay::LogVersion)
+    {
+        Reader.Reset();
+        return false;
+    }
+    
+    return true;
+}
+
+bool FEnemySpawnReplayReader::Next(FEnemyReplayRecord& OutRecord)
+{
+    if (!Reader || Reader->AtEnd())
+    {
+        return false;
+    }
+    
+    EnemySpawnReplay::SerializeRecord(*Reader, OutRecord, Paths, nullptr);
+    return !Reader->IsError() && OutRecord.Type != EEnemyReplayRecordType::End;
+}
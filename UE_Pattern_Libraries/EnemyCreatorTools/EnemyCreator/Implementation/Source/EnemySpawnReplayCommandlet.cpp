@@ -0,0 +1,195 @@
+#include "EnemySpawnReplayCommandlet.h"
+#include "EnemySpawnReplay.h"
+#include "EnemyCreatorTypes.h"
+#include "EnemyRuntimeRegistry.h"
+#include "BaseEnemy.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "Misc/Paths.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogEnemyReplay, Log, All);
+
+namespace EnemySpawnReplayCommandlet
+{
+    /** Measurements gathered across every replay pass */
+    struct FReplayStats
+    {
+        TArray<double> FrameMs;
+        TArray<double> SpawnMs;
+        int32 NumDecisions = 0;
+        int32 NumDivergedDecisions = 0;
+        int32 NumMissingAssets = 0;
+    };
+    
+    static UWorld* CreateReplayWorld()
+    {
+        UWorld* World = UWorld::CreateWorld(EWorldType::Game, false, TEXT("EnemySpawnReplay"));
+        FWorldContext& WorldContext = GEngine->CreateNewWorldContext(EWorldType::Game);
+        WorldContext.SetCurrentWorld(World);
+        World->InitializeActorsForPlay(FURL());
+        World->BeginPlay();
+        return World;
+    }
+    
+    static void DestroyReplayWorld(UWorld* World)
+    {
+        GEngine->DestroyWorldContext(World);
+        World->DestroyWorld(false);
+        CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+    }
+    
+    static void LogTimings(const TCHAR* Label, TArray<double>& Milliseconds)
+    {
+        if (Milliseconds.Num() == 0)
+        {
+            return;
+        }
+        
+        Milliseconds.Sort();
+        double Total = 0.0;
+        for (const double Value : Milliseconds)
+        {
+            Total += Value;
+        }
+        
+        const double P95 = Milliseconds[FMath::FloorToInt32(0.95 * (Milliseconds.Num() - 1))];
+        UE_LOG(LogEnemyReplay, Display, TEXT("%s: %d, total %.2f ms, mean %.3f ms, p95 %.3f ms, max %.3f ms"),
+            Label, Milliseconds.Num(), Total, Total / Milliseconds.Num(), P95, Milliseconds.Last());
+    }
+    
+    /** Replay a log once in a fresh world, appending to Stats */
+    static bool Replay(const FString& Filename, FReplayStats& Stats)
+    {
+        FEnemySpawnReplayReader Reader;
+        if (!Reader.Open(Filename))
+        {
+            UE_LOG(LogEnemyReplay, Error, TEXT("Could not read enemy replay %s"), *Filename);
+            return false;
+        }
+        
+        UWorld* World = CreateReplayWorld();
+        UEnemyRuntimeRegistry* Registry = World->GetSubsystem<UEnemyRuntimeRegistry>();
+        TMap<int32, TWeakObjectPtr<ABaseEnemy>> Enemies;
+        
+        FEnemyReplayRecord Record;
+        while (Reader.Next(Record))
+        {
+            switch (Record.Type)
+            {
+            case EEnemyReplayRecordType::Frame:
+            {
+                TRACE_CPUPROFILER_EVENT_SCOPE(EnemyReplay_Frame);
+                const double StartTime = FPlatformTime::Seconds();
+                World->Tick(LEVELTICK_All, Record.DeltaTime);
+                Stats.FrameMs.Add((FPlatformTime::Seconds() - StartTime) * 1000.0);
+                break;
+            }
+            
+            case EEnemyReplayRecordType::Spawn:
+            {
+                UEnemyConfiguration* Configuration = Cast<UEnemyConfiguration>(Record.Configuration.TryLoad());
+                UClass* EnemyClass = Cast<UClass>(Record.EnemyClass.TryLoad());
+                if (!Configuration || !EnemyClass || !EnemyClass->IsChildOf<ABaseEnemy>())
+                {
+                    ++Stats.NumMissingAssets;
+                    break;
+                }
+                
+                // Loads stay outside the timed region; in the session they were streamed ahead of the spawn
+                Configuration->BaseTemplate.LoadSynchronous();
+                
+                TRACE_CPUPROFILER_EVENT_SCOPE(EnemyReplay_Spawn);
+                const double StartTime = FPlatformTime::Seconds();
+                ABaseEnemy* Enemy = Enemies.FindRef(Record.EnemyId).Get();
+                if (!Enemy)
+                {
+                    FActorSpawnParameters SpawnParameters;
+                    SpawnParameters.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+                    Enemy = World->SpawnActor<ABaseEnemy>(EnemyClass, FVector(Record.Location), FRotator(0.0, Record.Yaw, 0.0), SpawnParameters);
+                    Enemies.Add(Record.EnemyId, Enemy);
+                }
+                
+                FMath::SRandInit(Record.Seed);
+                Configuration->ApplyConfiguration(Enemy);
+                Stats.SpawnMs.Add((FPlatformTime::Seconds() - StartTime) * 1000.0);
+                break;
+            }
+            
+            case EEnemyReplayRecordType::AbilityDecision:
+            {
+                ABaseEnemy* Enemy = Enemies.FindRef(Record.EnemyId).Get();
+                const FEnemyResolvedTemplatePtr Template = Registry && Enemy ? Registry->FindTemplate(Enemy) : nullptr;
+                if (!Template)
+                {
+                    break;
+                }
+                
+                // Abilities edited since the recording cannot take the recorded cooldowns; count those as diverged
+                ++Stats.NumDecisions;
+                if (Record.CooldownRemaining.Num() != 0 && Record.CooldownRemaining.Num() != Template->Abilities->Num())
+                {
+                    ++Stats.NumDivergedDecisions;
+                    break;
+                }
+                
+                const int32 SelectedAbility = Registry->SelectAbility(Enemy, Record.Distance, Record.CooldownRemaining, Record.AvailableResource);
+                Stats.NumDivergedDecisions += SelectedAbility != Record.SelectedAbility ? 1 : 0;
+                break;
+            }
+            
+            default:
+                break;
+            }
+        }
+        
+        DestroyReplayWorld(World);
+        return true;
+    }
+}
+
+UEnemySpawnReplayCommandlet::UEnemySpawnReplayCommandlet()
+{
+    IsClient = false;
+    IsEditor = false;
+    IsServer = false;
+    LogToConsole = true;
+}
+
+int32 UEnemySpawnReplayCommandlet::Main(const FString& Params)
+{
+    using namespace EnemySpawnReplayCommandlet;
+    
+    FString Filename;
+    if (!FParse::Value(*Params, TEXT("Replay="), Filename))
+    {
+        UE_LOG(LogEnemyReplay, Error, TEXT("Usage: -run=EnemySpawnReplay -Replay=<File or recording name> [-Loops=N]"));
+        return 1;
+    }
+    
+    // A bare recording name resolves to the default recording location
+    if (!FPaths::FileExists(Filename))
+    {
+        Filename = EnemySpawnReplay::GetReplayFilename(Filename);
+    }
+    
+    int32 NumLoops = 1;
+    FParse::Value(*Params, TEXT("Loops="), NumLoops);
+    
+    FReplayStats Stats;
+    for (int32 Loop = 0; Loop < FMath::Max(1, NumLoops); ++Loop)
+    {
+        if (!Replay(Filename, Stats))
+        {
+            return 1;
+        }
+    }
+    
+    LogTimings(TEXT("Frames"), Stats.FrameMs);
+    LogTimings(TEXT("Spawns"), Stats.SpawnMs);
+    UE_LOG(LogEnemyReplay, Display, TEXT("Decisions: %d, diverged: %d, missing assets: %d"),
+        Stats.NumDecisions, Stats.NumDivergedDecisions, Stats.NumMissingAssets);
+    
+    // A diverged decision means the replay no longer reproduces the session
+    return Stats.NumDivergedDecisions > 0 ? 2 : 0;
+}
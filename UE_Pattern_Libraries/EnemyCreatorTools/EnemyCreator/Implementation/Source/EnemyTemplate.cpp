@@ -1,6 +1,16 @@
 #include "EnemyTemplate.h"
+#include "EnemyTemplateBuilder.h"
+#include "EnemyTemplateDiff.h"
+#include "EnemyTypeTraits.h"
+#include "EnemyCreatorSettings.h"
+#include "EnemyCreatorCustomVersion.h"
 #include "GameFramework/Character.h"
 #include "AbilitySystemComponent.h"
+#include "Misc/ScopeRWLock.h"
+#include "EnemyRuntimeRegistry.h"
+#include "EnemyVisualLODComponent.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogEnemyTemplate, Log, All);
 
 UEnemyTemplate::UEnemyTemplate()
 {
@@ -8,13 +18,237 @@ UEnemyTemplate::UEnemyTemplate()
     BaseStats = FEnemyBaseStats();
     AIConfig = FEnemyAIConfig();
     VisualCustomization = FEnemyVisualCustomization();
-    bNeedsInheritanceChainUpdate = true;
+}
+
+namespace EnemyTemplateTags
+{
+    const FName DisplayName(TEXT("EnemyDisplayName"));
+    const FName EnemyType(TEXT("EnemyType"));
+    const FName ParentTemplate(TEXT("EnemyParentTemplate"));
+    const FName GameplayTags(TEXT("EnemyTemplateTags"));
+    const FName NumAbilities(TEXT("EnemyNumAbilities"));
+    const FName VisualHash(TEXT("EnemyVisualHash"));
+}
+
+namespace EnemyTemplate
+{
+    /** Loaded templates by the parent they name, so edits reach descendants without scanning the library. Game thread only */
+    static TMap<FSoftObjectPath, TArray<TWeakObjectPtr<UEnemyTemplate>>> ChildrenByParent;
+    
+    /** Nearest template in the chain, starting at Template, that defines the block DefinesBlock tests for */
+    template <typename PredicateType>
+    static const UEnemyTemplate& FindBlockOwner(const UEnemyTemplate& Template, PredicateType DefinesBlock)
+    {
+        TArray<const UEnemyTemplate*, TInlineAllocator<8>> Visited;
+        const UEnemyTemplate* Current = &Template;
+        
+        // An unloaded or circular parent falls back to the last template reached
+        while (!DefinesBlock(*Current))
+        {
+            Visited.Add(Current);
+            const UEnemyTemplate* Parent = Current->GetParentTemplate();
+            if (!Parent || Visited.Contains(Parent))
+            {
+                break;
+            }
+            Current = Parent;
+        }
+        
+        return *Current;
+    }
+    
+    /** Whether two snapshots publish different inherited registry tags, see GetAssetRegistryTags */
+    static bool InheritedTagsDiffer(const FEnemyResolvedTemplatePtr& A, const FEnemyResolvedTemplatePtr& B)
+    {
+        if (!A || !B)
+        {
+            return A != B;
+        }
+        return A->Abilities->Num() != B->Abilities->Num()
+            || A->Visuals->GetContentHash() != B->Visuals->GetContentHash();
+    }
+}
+
+void UEnemyTemplate::Serialize(FArchive& Ar)
+{
+    Super::Serialize(Ar);
+    
+    Ar.UsingCustomVersion(FEnemyCreatorCustomVersion::GUID);
+}
+
+void UEnemyTemplate::PostLoad()
+{
+    Super::PostLoad();
+    
+    // Older packages have no hard reference yet; they pick one up from a parent that happens to be loaded
+    if (!ParentTemplateReference)
+    {
+        ParentTemplateReference = ParentTemplate.Get();
+    }
+    
+    // Children saved before block inheritance held full copies without override flags. Only a block that differs
+    // from the parent's is an override; without a loaded parent the stored copy stays an override, as it used to be.
+    // Newer children leave inherited blocks default-constructed with their flag clear, so they never migrate
+    const bool bBeforeOverrideFlags = GetLinkerCustomVersion(FEnemyCreatorCustomVersion::GUID) < FEnemyCreatorCustomVersion::BlockOverrideFlags;
+    if (bBeforeOverrideFlags && !ParentTemplate.IsNull())
+    {
+        const UEnemyTemplate* Parent = GetParentTemplate();
+        if (!bOverrideBaseStats)
+        {
+            const FEnemyBaseStats ParentStats = Parent ? Parent->GetBaseStats() : FEnemyBaseStats();
+            bOverrideBaseStats = !FEnemyBaseStats::StaticStruct()->CompareScriptStruct(&BaseStats, &ParentStats, PPF_None);
+        }
+        
+        if (!bOverrideAIConfig)
+        {
+            const FEnemyAIConfig ParentAIConfig = Parent ? Parent->GetAIConfig() : FEnemyAIConfig();
+            bOverrideAIConfig = !FEnemyAIConfig::StaticStruct()->CompareScriptStruct(&AIConfig, &ParentAIConfig, PPF_None);
+        }
+        
+        if (!bOverrideVisuals)
+        {
+            const FEnemyVisualCustomization ParentVisuals = Parent ? Parent->GetVisualCustomization() : FEnemyVisualCustomization();
+            bOverrideVisuals = !FEnemyVisualCustomization::StaticStruct()->CompareScriptStruct(&VisualCustomization, &ParentVisuals, PPF_None);
+        }
+    }
+    
+    UpdateParentIndex(ParentTemplate.ToSoftObjectPath());
+    PublishResolvedTemplate();
+}
+
+void UEnemyTemplate::BeginDestroy()
+{
+    UpdateParentIndex(FSoftObjectPath());
+    
+    Super::BeginDestroy();
+}
+
+void UEnemyTemplate::GetAssetRegistryTags(TArray<FAssetRegistryTag>& OutTags) const
+{
+    Super::GetAssetRegistryTags(OutTags);
+    
+    OutTags.Emplace(EnemyTemplateTags::DisplayName, DisplayName.ToString(), FAssetRegistryTag::TT_Alphabetical);
+    OutTags.Emplace(EnemyTemplateTags::EnemyType, StaticEnum<EEnemyType>()->GetNameStringByValue(static_cast<int64>(EnemyType)), FAssetRegistryTag::TT_Alphabetical);
+    OutTags.Emplace(EnemyTemplateTags::ParentTemplate, ParentTemplate.ToString(), FAssetRegistryTag::TT_Hidden);
+    OutTags.Emplace(EnemyTemplateTags::GameplayTags, TemplateTags.ToString(), FAssetRegistryTag::TT_Hidden);
+    
+    // Inherited abilities included, so list rows show the count the enemy actually has. Like the visual hash
+    // below, it is only as fresh as this template's last save; see PostEditChangeProperty
+    const FEnemyResolvedTemplatePtr Resolved = GetResolvedTemplate();
+    const int32 NumAbilities = Resolved ? Resolved->Abilities->Num() : Abilities.Num();
+    OutTags.Emplace(EnemyTemplateTags::NumAbilities, LexToString(NumAbilities), FAssetRegistryTag::TT_Numerical);
+    
+    // Lets the template browser find a cached thumbnail without loading the template
+    if (Resolved)
+    {
+        OutTags.Emplace(EnemyTemplateTags::VisualHash, FString::Printf(TEXT("%016llx"), Resolved->Visuals->GetContentHash()), FAssetRegistryTag::TT_Hidden);
+    }
+}
+
+void UEnemyTemplate::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+    Super::PostEditChangeProperty(PropertyChangedEvent);
+    
+    if (!bUndoingEdit)
+    {
+        RefreshAfterEdit();
+    }
+}
+
+void UEnemyTemplate::PostEditUndo()
+{
+    {
+        TGuardValue<bool> UndoGuard(bUndoingEdit, true);
+        Super::PostEditUndo();
+    }
+    
+    // Undo restores properties behind the builder's back, including a bulk edit's stat copies
+    RefreshAfterEdit();
+}
+
+void UEnemyTemplate::RefreshAfterEdit()
+{
+    // A parent picked in the editor may not be loaded yet; edits are the one place a parent is loaded on demand
+    ParentTemplateReference = ParentTemplate.LoadSynchronous();
+    UpdateParentIndex(ParentTemplate.ToSoftObjectPath());
+    PublishResolvedTemplate();
+    
+    // Children resolve through us, so their snapshots are stale too, and so are their saved inherited tags
+    TArray<UEnemyTemplate*> Descendants;
+    GetLoadedDescendants(Descendants);
+    for (UEnemyTemplate* Descendant : Descendants)
+    {
+        const FEnemyResolvedTemplatePtr Previous = Descendant->GetResolvedTemplate();
+        Descendant->PublishResolvedTemplate();
+        if (EnemyTemplate::InheritedTagsDiffer(Previous, Descendant->GetResolvedTemplate()))
+        {
+            Descendant->MarkPackageDirty();
+        }
+    }
+}
+
+FEnemyResolvedTemplatePtr UEnemyTemplate::GetResolvedTemplate() const
+{
+    FReadScopeLock ReadLock(ResolvedSnapshotLock);
+    return ResolvedSnapshot;
+}
+
+void UEnemyTemplate::PublishResolvedTemplate()
+{
+    check(IsInGameThread());
+    
+    // A snapshot built without its parent would carry this template's own default blocks in place of inherited ones
+    if (!ParentTemplate.IsNull() && !GetParentTemplate())
+    {
+        UE_LOG(LogEnemyTemplate, Warning, TEXT("Enemy template %s has no loaded parent %s; blocks it inherits resolve to its own"),
+            *GetPathName(), *ParentTemplate.ToString());
+    }
+    
+    // Build outside the lock; only the pointer swap is serialized
+    FEnemyResolvedTemplatePtr NewSnapshot = FEnemyResolvedTemplate::Build(*this);
+    
+    FWriteScopeLock WriteLock(ResolvedSnapshotLock);
+    Swap(ResolvedSnapshot, NewSnapshot);
 }
 
 bool UEnemyTemplate::ValidateTemplate(FEnemyTemplateValidationResult& OutResult) const
 {
     OutResult.Clear();
     
+    FEnemyCreatorScratchScope Scratch;
+    TEnemyScratchMap<const UEnemyTemplate*, bool> ValidatedTemplates;
+    return ValidateTemplateInto(OutResult, ValidatedTemplates);
+}
+
+int32 UEnemyTemplate::ValidateTemplates(TArrayView<const UEnemyTemplate* const> Templates, TArray<FEnemyTemplateValidationResult>& OutResults)
+{
+    // One scratch scope for the whole library; shared parents are validated once
+    FEnemyCreatorScratchScope Scratch;
+    TEnemyScratchMap<const UEnemyTemplate*, bool> ValidatedTemplates;
+    ValidatedTemplates.Reserve(Templates.Num());
+    
+    OutResults.SetNum(Templates.Num());
+    
+    int32 NumInvalid = 0;
+    for (int32 Index = 0; Index < Templates.Num(); ++Index)
+    {
+        OutResults[Index].Clear();
+        if (!Templates[Index] || !Templates[Index]->ValidateTemplateInto(OutResults[Index], ValidatedTemplates))
+        {
+            ++NumInvalid;
+        }
+    }
+    
+    return NumInvalid;
+}
+
+bool UEnemyTemplate::ValidateTemplateInto(FEnemyTemplateValidationResult& OutResult, TEnemyScratchMap<const UEnemyTemplate*, bool>& ValidatedTemplates) const
+{
+    const int32 FirstError = OutResult.ValidationErrors.Num();
+    
+    // Mark in progress so circular inheritance terminates as invalid
+    ValidatedTemplates.Add(this, false);
+    
     // Validate basic properties
     if (TemplateName.IsNone())
     {
@@ -26,39 +260,59 @@ bool UEnemyTemplate::ValidateTemplate(FEnemyTemplateValidationResult& OutResult)
         OutResult.AddWarning(NSLOCTEXT("EnemyCreator", "NoDisplayName", "Display name is empty"));
     }
     
-    // Validate parent template
-    if (ParentTemplate)
+    // Validate parent template straight into our result instead of a temporary one; only its errors are kept
+    const UEnemyTemplate* Parent = GetParentTemplate();
+    if (!Parent && !ParentTemplate.IsNull())
+    {
+        OutResult.AddError(FText::Format(
+            NSLOCTEXT("EnemyCreator", "MissingParentTemplate", "Parent template '{0}' is not loaded"),
+            FText::FromString(ParentTemplate.ToString())));
+    }
+    else if (Parent)
     {
-        FEnemyTemplateValidationResult ParentResult;
-        if (!ParentTemplate->ValidateTemplate(ParentResult))
+        const int32 ParentFirstError = OutResult.ValidationErrors.Num();
+        const int32 ParentFirstWarning = OutResult.ValidationWarnings.Num();
+        
+        const bool* bKnownValid = ValidatedTemplates.Find(Parent);
+        const bool bParentValid = bKnownValid ? *bKnownValid : Parent->ValidateTemplateInto(OutResult, ValidatedTemplates);
+        if (!bParentValid)
         {
-            OutResult.AddError(FText::Format(
+            OutResult.ValidationErrors.Insert(FText::Format(
                 NSLOCTEXT("EnemyCreator", "InvalidParentTemplate", "Parent template '{0}' is invalid"),
-                FText::FromString(ParentTemplate->GetTemplateName().ToString())
-            ));
-            OutResult.ValidationErrors.Append(ParentResult.ValidationErrors);
+                FText::FromString(Parent->GetTemplateName().ToString())
+            ), ParentFirstError);
+            OutResult.bIsValid = false;
         }
+        
+        OutResult.ValidationWarnings.SetNum(ParentFirstWarning);
     }
     
-    // Validate visual assets
-    if (!ValidateVisualAssets(OutResult))
+    if (EnemyType != EEnemyType::Boss && Phases.Num() > 0)
     {
-        return false;
+        OutResult.AddWarning(NSLOCTEXT("EnemyCreator", "PhasesIgnored", "Phases only run on Boss templates"));
     }
     
-    // Validate AI configuration
-    if (!ValidateAIConfiguration(OutResult))
+    if (EnemyType == EEnemyType::Boss
+        && !UEnemyCreatorSettings::Get()->HealthAttribute.IsValid()
+        && GetPhases().ContainsByPredicate([](const FEnemyPhaseDefinition& Phase) { return Phase.HealthThreshold > 0.0f; }))
     {
-        return false;
+        OutResult.AddWarning(NSLOCTEXT("EnemyCreator", "NoPhaseHealthAttribute", "Phase health thresholds never trigger until a Health Attribute is set in Enemy Creator settings"));
     }
     
-    // Validate abilities
-    if (!ValidateAbilities(OutResult))
+    if (!EnemyTypeTraits::HasAuras(EnemyType)
+        && Abilities.ContainsByPredicate([](const FEnemyAbilityDefinition& Ability) { return Ability.AuraType != EEnemyAuraType::None; }))
     {
-        return false;
+        OutResult.AddWarning(NSLOCTEXT("EnemyCreator", "AurasIgnored", "Aura abilities only pulse on Support templates"));
     }
     
-    return OutResult.bIsValid;
+    // Validate visual assets, AI configuration and abilities, stopping at the first failing group
+    const bool bIsValid = ValidateVisualAssets(OutResult)
+        && ValidateAIConfiguration(OutResult)
+        && ValidateAbilities(OutResult)
+        && OutResult.ValidationErrors.Num() == FirstError;
+    
+    ValidatedTemplates.Add(this, bIsValid);
+    return bIsValid;
 }
 
 bool UEnemyTemplate::ApplyToInstance(ACharacter* EnemyInstance, const FEnemyTemplateModification* Modification) const
@@ -68,98 +322,271 @@ bool UEnemyTemplate::ApplyToInstance(ACharacter* EnemyInstance, const FEnemyTemp
         return false;
     }
     
-    // Apply base stats
-    FEnemyBaseStats FinalStats = BaseStats;
+    // Work from the published snapshot so inherited abilities are included
+    FEnemyResolvedTemplatePtr Resolved = GetResolvedTemplate();
+    if (!Resolved)
+    {
+        Resolved = FEnemyResolvedTemplate::Build(*this);
+    }
+    
+    // Ad-hoc modifications derive a variant here; configurations cache theirs and call ApplyResolved directly
     if (Modification)
     {
-        for (const auto& StatMod : Modification->StatMultipliers)
+        Resolved = FEnemyResolvedTemplate::BuildVariant(Resolved.ToSharedRef(), *Modification);
+    }
+    
+    return ApplyResolved(EnemyInstance, Resolved.ToSharedRef());
+}
+
+namespace EnemyTemplate
+{
+    template <EEnemyType Type>
+    struct TApplyResolved
+    {
+        static bool Invoke(const UEnemyTemplate& Template, ACharacter* EnemyInstance, const FEnemyResolvedTemplateRef& Resolved)
         {
-            float* StatValue = GetStatValuePtr(FinalStats, StatMod.Key);
-            if (StatValue)
+            // Apply visual customization
+            Template.ApplyVisualCustomization(EnemyInstance, Resolved->Visuals);
+            
+            // Apply AI configuration
+            Template.ApplyAIConfiguration(EnemyInstance, *Resolved->AIConfig);
+            
+            // Apply abilities
+            UAbilitySystemComponent* AbilitySystem = EnemyInstance->FindComponentByClass<UAbilitySystemComponent>();
+            if (AbilitySystem)
+            {
+                const FEnemyAbilityTable& ResolvedAbilities = *Resolved->Abilities;
+                for (const FEnemyAbilityRecord& Record : ResolvedAbilities.Records)
+                {
+                    Template.ApplyAbility(AbilitySystem, ResolvedAbilities.GetColdData(Record));
+                }
+            }
+            
+            // Register with the world's runtime registry so trait queries can find this enemy
+            UEnemyRuntimeRegistry* Registry = UWorld::GetSubsystem<UEnemyRuntimeRegistry>(EnemyInstance->GetWorld());
+            if (!Registry)
+            {
+                return true;
+            }
+            
+            Registry->RegisterEnemy(EnemyInstance, Resolved);
+            
+            if constexpr (TEnemyTypeTraits<Type>::bHasPhases)
             {
-                *StatValue *= StatMod.Value;
+                Registry->StartPhaseMachine(EnemyInstance, Template, Resolved);
             }
+            
+            return true;
         }
+    };
+}
+
+bool UEnemyTemplate::ApplyResolved(ACharacter* EnemyInstance, const FEnemyResolvedTemplateRef& Resolved) const
+{
+    if (!EnemyInstance)
+    {
+        return false;
     }
     
-    // Apply visual customization
-    FEnemyVisualCustomization FinalVisuals = VisualCustomization;
-    if (Modification)
+    using FApplyFunction = bool (*)(const UEnemyTemplate&, ACharacter*, const FEnemyResolvedTemplateRef&);
+    return TEnemyTypeDispatchTable<FApplyFunction, EnemyTemplate::TApplyResolved>::Get(Resolved->EnemyType)(*this, EnemyInstance, Resolved);
+}
+
+void UEnemyTemplate::ApplyTransition(ACharacter* EnemyInstance, const FEnemyResolvedTemplate& From, const FEnemyResolvedTemplate& To) const
+{
+    if (!EnemyInstance)
     {
-        FinalVisuals = Modification->VisualModifications;
+        return;
     }
-    ApplyVisualCustomization(EnemyInstance, FinalVisuals);
     
-    // Apply AI configuration
-    FEnemyAIConfig FinalAIConfig = AIConfig;
-    if (Modification)
+    // Facets are interned, so an unchanged block is the same pointer and costs nothing here
+    if (From.Visuals != To.Visuals)
     {
-        FinalAIConfig = Modification->AIModifications;
+        ApplyVisualCustomization(EnemyInstance, To.Visuals);
+    }
+    
+    if (From.AIConfig != To.AIConfig)
+    {
+        ApplyAIConfiguration(EnemyInstance, *To.AIConfig);
     }
-    ApplyAIConfiguration(EnemyInstance, FinalAIConfig);
     
-    // Apply abilities
     UAbilitySystemComponent* AbilitySystem = EnemyInstance->FindComponentByClass<UAbilitySystemComponent>();
-    if (AbilitySystem)
+    if (!AbilitySystem || From.Abilities == To.Abilities)
+    {
+        return;
+    }
+    
+    const FEnemyAbilityTable& OldAbilities = *From.Abilities;
+    const FEnemyAbilityTable& NewAbilities = *To.Abilities;
+    
+    // Only abilities that were added, dropped or redefined; unchanged ones keep their specs
+    TArray<TPair<int32, int32>, TInlineAllocator<8>> ChangedAbilities;
+    FEnemyTemplateDiff::DiffAbilities(OldAbilities, NewAbilities, [&ChangedAbilities](FName, int32 OldIndex, int32 NewIndex)
     {
-        for (const auto& Ability : Abilities)
+        ChangedAbilities.Emplace(OldIndex, NewIndex);
+    });
+    
+    // Withdraw every old definition before granting, so a redefinition sharing a class is not withdrawn after its grant
+    for (const TPair<int32, int32>& Change : ChangedAbilities)
+    {
+        if (Change.Key != INDEX_NONE)
         {
-            if (Modification && Modification->ModifiedAbilities.Contains(Ability.AbilityName))
-            {
-                ApplyAbility(AbilitySystem, Modification->ModifiedAbilities[Ability.AbilityName]);
-            }
-            else
+            const TSoftClassPtr<UGameplayAbility>& AbilityClass = OldAbilities.GetColdData(OldAbilities.Records[Change.Key]).AbilityClass;
+            if (FGameplayAbilitySpec* Spec = AbilityClass.IsValid() ? AbilitySystem->FindAbilitySpecFromClass(AbilityClass.Get()) : nullptr)
             {
-                ApplyAbility(AbilitySystem, Ability);
+                AbilitySystem->ClearAbility(Spec->Handle);
             }
         }
     }
     
-    return true;
+    for (const TPair<int32, int32>& Change : ChangedAbilities)
+    {
+        if (Change.Value != INDEX_NONE)
+        {
+            ApplyAbility(AbilitySystem, NewAbilities.GetColdData(NewAbilities.Records[Change.Value]));
+        }
+    }
 }
 
 UEnemyTemplate* UEnemyTemplate::CreateChildTemplate(const FName& NewTemplateName)
 {
+    // Blocks stay with this template until the child overrides them, so deep hierarchies hold one copy of each
     UEnemyTemplate* ChildTemplate = NewObject<UEnemyTemplate>();
-    ChildTemplate->ParentTemplate = this;
-    ChildTemplate->TemplateName = NewTemplateName;
-    
-    // Inherit properties
-    ChildTemplate->BaseStats = BaseStats;
-    ChildTemplate->AIConfig = AIConfig;
-    ChildTemplate->VisualCustomization = VisualCustomization;
-    ChildTemplate->Abilities = Abilities;
+    FEnemyTemplateBuilder(ChildTemplate)
+        .SetParent(this)
+        .SetName(NewTemplateName)
+        .SetEnemyType(EnemyType)
+        .Publish();
     
     return ChildTemplate;
 }
 
-const TArray<UEnemyTemplate*>& UEnemyTemplate::GetInheritanceChain() const
+UEnemyTemplate* UEnemyTemplate::GetParentTemplate() const
+{
+    return ParentTemplate.Get();
+}
+
+const FEnemyBaseStats& UEnemyTemplate::GetBaseStats() const
+{
+    return EnemyTemplate::FindBlockOwner(*this, [](const UEnemyTemplate& Link) { return Link.DefinesBaseStats(); }).BaseStats;
+}
+
+const FEnemyAIConfig& UEnemyTemplate::GetAIConfig() const
+{
+    return EnemyTemplate::FindBlockOwner(*this, [](const UEnemyTemplate& Link) { return Link.DefinesAIConfig(); }).AIConfig;
+}
+
+const FEnemyVisualCustomization& UEnemyTemplate::GetVisualCustomization() const
 {
-    if (bNeedsInheritanceChainUpdate)
+    return EnemyTemplate::FindBlockOwner(*this, [](const UEnemyTemplate& Link) { return Link.DefinesVisuals(); }).VisualCustomization;
+}
+
+const TArray<FEnemyPhaseDefinition>& UEnemyTemplate::GetPhases() const
+{
+    return EnemyTemplate::FindBlockOwner(*this, [](const UEnemyTemplate& Link) { return Link.Phases.Num() > 0 || Link.ParentTemplate.IsNull(); }).Phases;
+}
+
+TArray<UEnemyTemplate*> UEnemyTemplate::GetInheritanceChain() const
+{
+    // Walk into a local array; nothing on the template is written, so concurrent callers never race
+    TArray<UEnemyTemplate*> Chain;
+    UEnemyTemplate* Current = const_cast<UEnemyTemplate*>(this);
+    
+    while (Current)
     {
-        CachedInheritanceChain.Empty();
-        UEnemyTemplate* Current = const_cast<UEnemyTemplate*>(this);
+        // Detect circular inheritance
+        if (Chain.Contains(Current))
+        {
+            break;
+        }
         
-        while (Current)
+        Chain.Add(Current);
+        Current = Current->GetParentTemplate();
+    }
+    
+    return Chain;
+}
+
+void UEnemyTemplate::GetLoadedChildren(TArray<UEnemyTemplate*>& OutChildren) const
+{
+    check(IsInGameThread());
+    
+    if (const TArray<TWeakObjectPtr<UEnemyTemplate>>* Children = EnemyTemplate::ChildrenByParent.Find(FSoftObjectPath(this)))
+    {
+        for (const TWeakObjectPtr<UEnemyTemplate>& Child : *Children)
         {
-            CachedInheritanceChain.Add(Current);
-            Current = Current->ParentTemplate;
-            
-            // Detect circular inheritance
-            if (CachedInheritanceChain.Contains(Current))
+            if (UEnemyTemplate* LoadedChild = Child.Get())
             {
-                break;
+                OutChildren.Add(LoadedChild);
             }
         }
+    }
+}
+
+void UEnemyTemplate::GetLoadedDescendants(TArray<UEnemyTemplate*>& OutDescendants) const
+{
+    // Breadth first over the index; the visited set stops circular inheritance
+    TSet<const UEnemyTemplate*> Visited;
+    Visited.Add(this);
+    
+    const int32 FirstDescendant = OutDescendants.Num();
+    GetLoadedChildren(OutDescendants);
+    for (int32 Index = FirstDescendant; Index < OutDescendants.Num();)
+    {
+        bool bAlreadyVisited = false;
+        Visited.Add(OutDescendants[Index], &bAlreadyVisited);
+        if (bAlreadyVisited)
+        {
+            OutDescendants.RemoveAt(Index);
+            continue;
+        }
         
-        bNeedsInheritanceChainUpdate = false;
+        OutDescendants[Index]->GetLoadedChildren(OutDescendants);
+        ++Index;
+    }
+}
+
+void UEnemyTemplate::UpdateParentIndex(const FSoftObjectPath& NewParent)
+{
+    check(IsInGameThread());
+    
+    if (NewParent == IndexedParent)
+    {
+        return;
     }
     
-    return CachedInheritanceChain;
+    if (TArray<TWeakObjectPtr<UEnemyTemplate>>* Siblings = EnemyTemplate::ChildrenByParent.Find(IndexedParent))
+    {
+        Siblings->RemoveSwap(TWeakObjectPtr<UEnemyTemplate>(this));
+        if (Siblings->Num() == 0)
+        {
+            EnemyTemplate::ChildrenByParent.Remove(IndexedParent);
+        }
+    }
+    
+    IndexedParent = NewParent;
+    if (!IndexedParent.IsNull())
+    {
+        EnemyTemplate::ChildrenByParent.FindOrAdd(IndexedParent).Add(this);
+    }
 }
 
 bool UEnemyTemplate::ValidateVisualAssets(FEnemyTemplateValidationResult& OutResult) const
 {
+    // A parent's warnings are dropped from its children's results, so sharing is checked on inherited visuals too
+    const FEnemyVisualCustomization& Visuals = GetVisualCustomization();
+    const bool bAnySharingTier = Visuals.LODTiers.ContainsByPredicate([](const FEnemyVisualLODTier& Tier) { return Tier.bShareAnimation; });
+    if (bAnySharingTier && !Visuals.AnimationSharing.HasStates())
+    {
+        OutResult.AddWarning(NSLOCTEXT("EnemyCreator", "NoSharingStates", "LOD tiers share animation but no sharing states are set"));
+    }
+    
+    // Inherited assets were validated with the template that defines them
+    if (!DefinesVisuals())
+    {
+        return true;
+    }
+    
     // Validate skeletal mesh
     if (!VisualCustomization.SkeletalMesh.IsValid())
     {
@@ -178,6 +605,12 @@ bool UEnemyTemplate::ValidateVisualAssets(FEnemyTemplateValidationResult& OutRes
 
 bool UEnemyTemplate::ValidateAIConfiguration(FEnemyTemplateValidationResult& OutResult) const
 {
+    // Inherited AI configuration was validated with the template that defines it
+    if (!DefinesAIConfig())
+    {
+        return true;
+    }
+    
     // Validate behavior tree
     if (!AIConfig.BehaviorTree.IsValid())
     {
@@ -223,13 +656,22 @@ bool UEnemyTemplate::ValidateAbilities(FEnemyTemplateValidationResult& OutResult
     return bIsValid;
 }
 
-void UEnemyTemplate::ApplyVisualCustomization(ACharacter* EnemyInstance, const FEnemyVisualCustomization& Visuals) const
+void UEnemyTemplate::ApplyVisualCustomization(ACharacter* EnemyInstance, const FEnemyVisualsFacet& VisualsFacet) const
 {
     if (!EnemyInstance)
     {
         return;
     }
     
+    const FEnemyResolvedVisuals& Visuals = *VisualsFacet;
+    
+    // Return to full quality first so the parameters below land on the full-quality materials
+    UEnemyVisualLODComponent* LODComponent = EnemyInstance->FindComponentByClass<UEnemyVisualLODComponent>();
+    if (LODComponent)
+    {
+        LODComponent->ResetVisuals();
+    }
+    
     // Apply skeletal mesh
     if (USkeletalMeshComponent* MeshComponent = EnemyInstance->GetMesh())
     {
@@ -260,9 +702,19 @@ void UEnemyTemplate::ApplyVisualCustomization(ACharacter* EnemyInstance, const F
             }
         }
     }
+    
+    if (Visuals.LODTiers.Num() > 0)
+    {
+        if (!LODComponent)
+        {
+            LODComponent = NewObject<UEnemyVisualLODComponent>(EnemyInstance);
+            LODComponent->RegisterComponent();
+        }
+        LODComponent->SetVisuals(VisualsFacet);
+    }
 }
 
-void UEnemyTemplate::ApplyAIConfiguration(ACharacter* EnemyInstance, const FEnemyAIConfig& Config) const
+void UEnemyTemplate::ApplyAIConfiguration(ACharacter* EnemyInstance, const FEnemyResolvedAIConfig& Config) const
 {
     if (!EnemyInstance)
     {
@@ -296,25 +748,45 @@ void UEnemyTemplate::ApplyAIConfiguration(ACharacter* EnemyInstance, const FEnem
 
 void UEnemyTemplate::ApplyAbility(UAbilitySystemComponent* AbilitySystem, const FEnemyAbilityDefinition& Ability) const
 {
-    if (!AbilitySystem || !Ability.AbilityClass.IsValid())
+    GrantAbility(AbilitySystem, Ability.AbilityClass, Ability.AbilityEffects);
+}
+
+void UEnemyTemplate::ApplyAbility(UAbilitySystemComponent* AbilitySystem, const FEnemyAbilityColdData& Ability) const
+{
+    GrantAbility(AbilitySystem, Ability.AbilityClass, Ability.AbilityEffects);
+}
+
+void UEnemyTemplate::GrantAbility(UAbilitySystemComponent* AbilitySystem, const TSoftClassPtr<UGameplayAbility>& AbilityClass, const TArray<TSoftClassPtr<UGameplayEffect>>& AbilityEffects) const
+{
+    if (!AbilitySystem || !AbilityClass.IsValid())
     {
         return;
     }
     
     // Grant ability
     FGameplayAbilitySpec AbilitySpec(
-        Ability.AbilityClass.Get(),
+        AbilityClass.Get(),
         1,  // Level
         INDEX_NONE,  // Input ID
-        this  // Source object
+        const_cast<UEnemyTemplate*>(this)  // Source object
     );
     
     AbilitySystem->GiveAbility(AbilitySpec);
     
-    // Apply effects
-    for (const auto& Effect : Ability.AbilityEffects)
+    // Apply effects through the world's shared specs; worlds without a registry build them per grant
+    UEnemyRuntimeRegistry* Registry = UWorld::GetSubsystem<UEnemyRuntimeRegistry>(AbilitySystem->GetWorld());
+    for (const auto& Effect : AbilityEffects)
     {
-        if (Effect.IsValid())
+        if (!Effect.IsValid())
+        {
+            continue;
+        }
+        
+        if (Registry)
+        {
+            Registry->GetEffectSpecPool().ApplyToTarget(AbilitySystem, Effect.Get(), 1.0f, this);
+        }
+        else
         {
             FGameplayEffectContextHandle EffectContext = AbilitySystem->MakeEffectContext();
             EffectContext.AddSourceObject(this);
@@ -331,4 +803,16 @@ void UEnemyTemplate::ApplyAbility(UAbilitySystemComponent* AbilitySystem, const
             }
         }
     }
-} 
\ No newline at end of file
+}
+
+float* UEnemyTemplate::GetStatValuePtr(FEnemyBaseStats& Stats, FName StatName)
+{
+    if (StatName == GET_MEMBER_NAME_CHECKED(FEnemyBaseStats, Health)) return &Stats.Health;
+    if (StatName == GET_MEMBER_NAME_CHECKED(FEnemyBaseStats, Damage)) return &Stats.Damage;
+    if (StatName == GET_MEMBER_NAME_CHECKED(FEnemyBaseStats, Speed)) return &Stats.Speed;
+    if (StatName == GET_MEMBER_NAME_CHECKED(FEnemyBaseStats, AttackSpeed)) return &Stats.AttackSpeed;
+    if (StatName == GET_MEMBER_NAME_CHECKED(FEnemyBaseStats, Defense)) return &Stats.Defense;
+    if (StatName == GET_MEMBER_NAME_CHECKED(FEnemyBaseStats, CriticalChance)) return &Stats.CriticalChance;
+    if (StatName == GET_MEMBER_NAME_CHECKED(FEnemyBaseStats, CriticalMultiplier)) return &Stats.CriticalMultiplier;
+    return nullptr;
+}
\ No newline at end of file
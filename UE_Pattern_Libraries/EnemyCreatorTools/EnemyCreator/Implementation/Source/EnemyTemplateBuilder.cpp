@@ -0,0 +1,124 @@
+#include "EnemyTemplateBuilder.h"
+
+FEnemyTemplateBuilder::FEnemyTemplateBuilder(UEnemyTemplate* InTemplate)
+    : Template(InTemplate)
+{
+    check(Template);
+}
+
+FEnemyTemplateBuilder& FEnemyTemplateBuilder::SetName(FName TemplateName)
+{
+    Template->TemplateName = TemplateName;
+    return *this;
+}
+
+FEnemyTemplateBuilder& FEnemyTemplateBuilder::SetDisplayName(FText&& DisplayName)
+{
+    Template->DisplayName = MoveTemp(DisplayName);
+    return *this;
+}
+
+FEnemyTemplateBuilder& FEnemyTemplateBuilder::SetEnemyType(EEnemyType EnemyType)
+{
+    Template->EnemyType = EnemyType;
+    return *this;
+}
+
+FEnemyTemplateBuilder& FEnemyTemplateBuilder::SetParent(UEnemyTemplate* Parent)
+{
+    Template->ParentTemplate = Parent;
+    Template->ParentTemplateReference = Parent;
+    Template->UpdateParentIndex(Template->ParentTemplate.ToSoftObjectPath());
+    return *this;
+}
+
+FEnemyTemplateBuilder& FEnemyTemplateBuilder::AddTag(const FGameplayTag& Tag)
+{
+    Template->TemplateTags.AddTag(Tag);
+    return *this;
+}
+
+FEnemyBaseStats& FEnemyTemplateBuilder::EditBaseStats()
+{
+    if (!Template->bOverrideBaseStats)
+    {
+        if (!Template->DefinesBaseStats())
+        {
+            Template->BaseStats = Template->GetBaseStats();
+        }
+        Template->bOverrideBaseStats = true;
+    }
+    
+    return Template->BaseStats;
+}
+
+FEnemyAIConfig& FEnemyTemplateBuilder::EditAIConfig()
+{
+    if (!Template->bOverrideAIConfig)
+    {
+        if (!Template->DefinesAIConfig())
+        {
+            Template->AIConfig = Template->GetAIConfig();
+        }
+        Template->bOverrideAIConfig = true;
+    }
+    
+    return Template->AIConfig;
+}
+
+FEnemyVisualCustomization& FEnemyTemplateBuilder::EditVisuals()
+{
+    if (!Template->bOverrideVisuals)
+    {
+        if (!Template->DefinesVisuals())
+        {
+            Template->VisualCustomization = Template->GetVisualCustomization();
+        }
+        Template->bOverrideVisuals = true;
+    }
+    
+    return Template->VisualCustomization;
+}
+
+FEnemyTemplateBuilder& FEnemyTemplateBuilder::ResetAbilities(int32 ExpectedNum)
+{
+    Template->Abilities.Reset(ExpectedNum);
+    return *this;
+}
+
+FEnemyAbilityDefinition& FEnemyTemplateBuilder::EmplaceAbility(FName AbilityName, FText&& DisplayName, FText&& Description, float CooldownTime, float Range)
+{
+    FEnemyAbilityDefinition& Ability = Template->Abilities.Emplace_GetRef();
+    Ability.AbilityName = AbilityName;
+    Ability.DisplayName = MoveTemp(DisplayName);
+    Ability.Description = MoveTemp(Description);
+    Ability.CooldownTime = CooldownTime;
+    Ability.Range = Range;
+    return Ability;
+}
+
+FEnemyTemplateBuilder& FEnemyTemplateBuilder::AddAbility(FEnemyAbilityDefinition&& Ability)
+{
+    Template->Abilities.Add(MoveTemp(Ability));
+    return *this;
+}
+
+TArrayView<FEnemyAbilityDefinition> FEnemyTemplateBuilder::EditAbilities()
+{
+    return Template->Abilities;
+}
+
+FEnemyPhaseDefinition& FEnemyTemplateBuilder::EmplacePhase(FName PhaseName, float HealthThreshold, float TimeInPreviousPhase)
+{
+    FEnemyPhaseDefinition& Phase = Template->Phases.Emplace_GetRef();
+    Phase.PhaseName = PhaseName;
+    Phase.HealthThreshold = HealthThreshold;
+    Phase.TimeInPreviousPhase = TimeInPreviousPhase;
+    return Phase;
+}
+
+UEnemyTemplate* FEnemyTemplateBuilder::Publish()
+{
+    Template->PublishResolvedTemplate();
+    return Template;
+}
@@ -0,0 +1,397 @@
+#include "EnemyTemplateDiff.h"
+#include "EnemyTemplate.h"
+#include "EnemyCreatorTypes.h"
+#include "Curves/CurveFloat.h"
+#include "Algo/StableSort.h"
+
+namespace EnemyTemplateDiff
+{
+    static FString ToDiffString(float Value) { return FString::SanitizeFloat(Value); }
+    static FString ToDiffString(bool Value) { return Value ? TEXT("true") : TEXT("false"); }
+    static FString ToDiffString(FName Value) { return Value.ToString(); }
+    static FString ToDiffString(const FText& Value) { return Value.ToString(); }
+    static FString ToDiffString(const FVector& Value) { return Value.ToString(); }
+    static FString ToDiffString(const FLinearColor& Value) { return Value.ToString(); }
+    static FString ToDiffString(const FGameplayTagContainer& Value) { return Value.ToStringSimple(); }
+    static FString ToDiffString(const UObject* Value) { return GetPathNameSafe(Value); }
+    static FString ToDiffString(EEnemyType Value) { return UEnum::GetValueAsString(Value); }
+    static FString ToDiffString(EEnemyAuraType Value) { return UEnum::GetValueAsString(Value); }
+    
+    static FString ToDiffString(const FEnemyVisualLODTier& Value)
+    {
+        FString Text;
+        FEnemyVisualLODTier::StaticStruct()->ExportText(Text, &Value, nullptr, nullptr, PPF_None, nullptr);
+        return Text;
+    }
+    
+    template <typename ObjectType>
+    static FString ToDiffString(const TSoftObjectPtr<ObjectType>& Value) { return Value.ToString(); }
+    
+    template <typename ClassType>
+    static FString ToDiffString(const TSoftClassPtr<ClassType>& Value) { return Value.ToString(); }
+    
+    template <typename ElementType>
+    static FString ToDiffString(const TArray<ElementType>& Values)
+    {
+        return FString::JoinBy(Values, TEXT(", "), [](const ElementType& Value) { return ToDiffString(Value); });
+    }
+    
+    static FName KeyToName(FName Key) { return Key; }
+    static FName KeyToName(int32 Key) { return FName(*FString::FromInt(Key)); }
+    
+    /** Records differences into a diff, building value text only when field detail was requested */
+    struct FDiffWriter
+    {
+        FEnemyTemplateDiff& Diff;
+        bool bFields;
+        
+        void AddText(EEnemyDiffSection Section, FName Key, FName Field, FString&& Before, FString&& After)
+        {
+            Diff.ChangedSections |= Section;
+            if (bFields)
+            {
+                Diff.Fields.Add({ Section, Key, Field, MoveTemp(Before), MoveTemp(After) });
+            }
+        }
+        
+        /** Record a difference; a null side means the element is absent there */
+        template <typename ValueType>
+        void Add(EEnemyDiffSection Section, FName Key, FName Field, const ValueType* Before, const ValueType* After)
+        {
+            AddText(Section, Key, Field, bFields && Before ? ToDiffString(*Before) : FString(), bFields && After ? ToDiffString(*After) : FString());
+        }
+        
+        template <typename ValueType>
+        void Compare(EEnemyDiffSection Section, FName Key, FName Field, const ValueType& Before, const ValueType& After)
+        {
+            if (!(Before == After))
+            {
+                Add(Section, Key, Field, &Before, &After);
+            }
+        }
+        
+        void Compare(EEnemyDiffSection Section, FName Key, FName Field, const FText& Before, const FText& After)
+        {
+            if (!Before.EqualTo(After))
+            {
+                Add(Section, Key, Field, &Before, &After);
+            }
+        }
+        
+        /** One merge walk over two sorted maps, one difference per key */
+        template <typename KeyType, typename ValueType, typename BeforeAllocator, typename AfterAllocator>
+        void CompareMaps(EEnemyDiffSection Section, FName Field, const TEnemyFlatMap<KeyType, ValueType, BeforeAllocator>& Before, const TEnemyFlatMap<KeyType, ValueType, AfterAllocator>& After)
+        {
+            TEnemyFlatMap<KeyType, ValueType, BeforeAllocator>::Diff(Before, After, [this, Section, Field](const KeyType& Key, const ValueType* BeforeValue, const ValueType* AfterValue)
+            {
+                Add(Section, KeyToName(Key), Field, BeforeValue, AfterValue);
+            });
+        }
+        
+        template <typename KeyType, typename ValueType>
+        void CompareMaps(EEnemyDiffSection Section, FName Field, const TMap<KeyType, ValueType>& Before, const TMap<KeyType, ValueType>& After)
+        {
+            CompareMaps(Section, Field, TEnemyFlatMap<KeyType, ValueType>::FromMap(Before), TEnemyFlatMap<KeyType, ValueType>::FromMap(After));
+        }
+        
+        /** Compare every reflected property of a struct, for authored blocks without a hand-written comparison */
+        void CompareStruct(EEnemyDiffSection Section, FName Key, const UScriptStruct* Struct, const void* Before, const void* After)
+        {
+            for (TFieldIterator<FProperty> It(Struct); It; ++It)
+            {
+                if (It->Identical_InContainer(Before, After))
+                {
+                    continue;
+                }
+                
+                FString BeforeText;
+                FString AfterText;
+                if (bFields)
+                {
+                    It->ExportText_InContainer(0, BeforeText, Before, nullptr, nullptr, PPF_None);
+                    It->ExportText_InContainer(0, AfterText, After, nullptr, nullptr, PPF_None);
+                }
+                AddText(Section, Key, It->GetFName(), MoveTemp(BeforeText), MoveTemp(AfterText));
+            }
+        }
+    };
+    
+    /** An ability record compared by full content, so a flat map diff reports redefinitions */
+    struct FAbilityEntry
+    {
+        const FEnemyAbilityTable* Table;
+        int32 Index;
+        
+        bool operator==(const FAbilityEntry& Other) const { return Table->IsSameEntry(Index, *Other.Table, Other.Index); }
+    };
+    
+    using FAbilityMap = TEnemyFlatMap<FName, FAbilityEntry, TInlineAllocator<16>>;
+    
+    static FAbilityMap MakeAbilityMap(const FEnemyAbilityTable& Table)
+    {
+        TArray<FAbilityMap::ElementType, TInlineAllocator<16>> Pairs;
+        Pairs.Reserve(Table.Num());
+        for (int32 Index = 0; Index < Table.Num(); ++Index)
+        {
+            Pairs.Emplace(Table.Records[Index].AbilityName, FAbilityEntry{ &Table, Index });
+        }
+        return FAbilityMap::FromPairs(Pairs);
+    }
+    
+    static void CompareAbility(FDiffWriter& Writer, const FEnemyAbilityTable& BeforeTable, int32 BeforeIndex, const FEnemyAbilityTable& AfterTable, int32 AfterIndex)
+    {
+        constexpr EEnemyDiffSection Section = EEnemyDiffSection::Abilities;
+        const FEnemyAbilityRecord& Before = BeforeTable.Records[BeforeIndex];
+        const FEnemyAbilityRecord& After = AfterTable.Records[AfterIndex];
+        const FName Key = After.AbilityName;
+        
+        Writer.Compare(Section, Key, GET_MEMBER_NAME_CHECKED(FEnemyAbilityRecord, CooldownTime), Before.CooldownTime, After.CooldownTime);
+        Writer.Compare(Section, Key, GET_MEMBER_NAME_CHECKED(FEnemyAbilityRecord, Range), Before.Range, After.Range);
+        Writer.Compare(Section, Key, GET_MEMBER_NAME_CHECKED(FEnemyAbilityRecord, Cost), Before.Cost, After.Cost);
+        Writer.Compare(Section, Key, GET_MEMBER_NAME_CHECKED(FEnemyAbilityRecord, AuraType), Before.AuraType, After.AuraType);
+        Writer.Compare(Section, Key, GET_MEMBER_NAME_CHECKED(FEnemyAbilityRecord, AuraMagnitude), Before.AuraMagnitude, After.AuraMagnitude);
+        Writer.Compare(Section, Key, FName(TEXT("bIsPassive")), Before.IsPassive(), After.IsPassive());
+        
+        const FEnemyAbilityColdData& BeforeCold = BeforeTable.GetColdData(Before);
+        const FEnemyAbilityColdData& AfterCold = AfterTable.GetColdData(After);
+        Writer.Compare(Section, Key, GET_MEMBER_NAME_CHECKED(FEnemyAbilityColdData, DisplayName), BeforeCold.DisplayName, AfterCold.DisplayName);
+        Writer.Compare(Section, Key, GET_MEMBER_NAME_CHECKED(FEnemyAbilityColdData, Description), BeforeCold.Description, AfterCold.Description);
+        Writer.Compare(Section, Key, GET_MEMBER_NAME_CHECKED(FEnemyAbilityColdData, AbilityTags), BeforeCold.AbilityTags, AfterCold.AbilityTags);
+        Writer.Compare(Section, Key, GET_MEMBER_NAME_CHECKED(FEnemyAbilityColdData, AbilityClass), BeforeCold.AbilityClass, AfterCold.AbilityClass);
+        Writer.Compare(Section, Key, GET_MEMBER_NAME_CHECKED(FEnemyAbilityColdData, AbilityMontage), BeforeCold.AbilityMontage, AfterCold.AbilityMontage);
+        Writer.Compare(Section, Key, GET_MEMBER_NAME_CHECKED(FEnemyAbilityColdData, AbilityEffects), BeforeCold.AbilityEffects, AfterCold.AbilityEffects);
+    }
+    
+    static void CompareAIConfig(FDiffWriter& Writer, const FEnemyResolvedAIConfig& Before, const FEnemyResolvedAIConfig& After)
+    {
+        constexpr EEnemyDiffSection Section = EEnemyDiffSection::AIConfig;
+        Writer.Compare(Section, NAME_None, GET_MEMBER_NAME_CHECKED(FEnemyResolvedAIConfig, BehaviorTree), Before.BehaviorTree, After.BehaviorTree);
+        Writer.Compare(Section, NAME_None, GET_MEMBER_NAME_CHECKED(FEnemyResolvedAIConfig, Blackboard), Before.Blackboard, After.Blackboard);
+        Writer.Compare(Section, NAME_None, GET_MEMBER_NAME_CHECKED(FEnemyResolvedAIConfig, AggressionLevel), Before.AggressionLevel, After.AggressionLevel);
+        Writer.Compare(Section, NAME_None, GET_MEMBER_NAME_CHECKED(FEnemyResolvedAIConfig, PreferredRange), Before.PreferredRange, After.PreferredRange);
+        Writer.Compare(Section, NAME_None, GET_MEMBER_NAME_CHECKED(FEnemyResolvedAIConfig, bUseCover), Before.bUseCover, After.bUseCover);
+        Writer.Compare(Section, NAME_None, GET_MEMBER_NAME_CHECKED(FEnemyResolvedAIConfig, bCoordinateWithAllies), Before.bCoordinateWithAllies, After.bCoordinateWithAllies);
+        Writer.CompareMaps(Section, GET_MEMBER_NAME_CHECKED(FEnemyResolvedAIConfig, BehaviorParameters), Before.BehaviorParameters, After.BehaviorParameters);
+        Writer.Compare(Section, NAME_None, GET_MEMBER_NAME_CHECKED(FEnemyResolvedAIConfig, PersonalityTags), Before.PersonalityTags, After.PersonalityTags);
+    }
+    
+    static void CompareVisuals(FDiffWriter& Writer, const FEnemyResolvedVisuals& Before, const FEnemyResolvedVisuals& After)
+    {
+        constexpr EEnemyDiffSection Section = EEnemyDiffSection::Visuals;
+        Writer.Compare(Section, NAME_None, GET_MEMBER_NAME_CHECKED(FEnemyResolvedVisuals, SkeletalMesh), Before.SkeletalMesh, After.SkeletalMesh);
+        Writer.Compare(Section, NAME_None, GET_MEMBER_NAME_CHECKED(FEnemyResolvedVisuals, AnimationBlueprint), Before.AnimationBlueprint, After.AnimationBlueprint);
+        Writer.Compare(Section, NAME_None, GET_MEMBER_NAME_CHECKED(FEnemyResolvedVisuals, Scale), Before.Scale, After.Scale);
+        Writer.Compare(Section, NAME_None, GET_MEMBER_NAME_CHECKED(FEnemyResolvedVisuals, ColorTint), Before.ColorTint, After.ColorTint);
+        Writer.CompareMaps(Section, GET_MEMBER_NAME_CHECKED(FEnemyResolvedVisuals, ScalarParameters), Before.ScalarParameters, After.ScalarParameters);
+        Writer.CompareMaps(Section, GET_MEMBER_NAME_CHECKED(FEnemyResolvedVisuals, VectorParameters), Before.VectorParameters, After.VectorParameters);
+        Writer.CompareMaps(Section, GET_MEMBER_NAME_CHECKED(FEnemyResolvedVisuals, TextureParameters), Before.TextureParameters, After.TextureParameters);
+        Writer.CompareMaps(Section, GET_MEMBER_NAME_CHECKED(FEnemyResolvedVisuals, MaterialOverrides), Before.MaterialOverrides, After.MaterialOverrides);
+        
+        // Tiers are ordered by significance, so position is their identity
+        const FName TiersField = GET_MEMBER_NAME_CHECKED(FEnemyResolvedVisuals, LODTiers);
+        for (int32 Index = 0; Index < FMath::Max(Before.LODTiers.Num(), After.LODTiers.Num()); ++Index)
+        {
+            const FEnemyVisualLODTier* BeforeTier = Before.LODTiers.IsValidIndex(Index) ? &Before.LODTiers[Index] : nullptr;
+            const FEnemyVisualLODTier* AfterTier = After.LODTiers.IsValidIndex(Index) ? &After.LODTiers[Index] : nullptr;
+            if (!BeforeTier || !AfterTier || *BeforeTier != *AfterTier)
+            {
+                Writer.Add(Section, KeyToName(Index), TiersField, BeforeTier, AfterTier);
+            }
+        }
+    }
+    
+    static void ComparePhases(FDiffWriter& Writer, const FEnemyResolvedTemplate& Before, const FEnemyResolvedTemplate& After)
+    {
+        // Definitions are shared by every snapshot derived from the same template, so this is usually one pointer compare
+        if (Before.PhaseDefinitions == After.PhaseDefinitions)
+        {
+            return;
+        }
+        
+        static const TArray<FEnemyPhaseDefinition> NoPhases;
+        const TArray<FEnemyPhaseDefinition>& BeforePhases = Before.PhaseDefinitions ? *Before.PhaseDefinitions : NoPhases;
+        const TArray<FEnemyPhaseDefinition>& AfterPhases = After.PhaseDefinitions ? *After.PhaseDefinitions : NoPhases;
+        
+        // Phases run in array order, so position is their identity
+        for (int32 Index = 0; Index < FMath::Max(BeforePhases.Num(), AfterPhases.Num()); ++Index)
+        {
+            const FEnemyPhaseDefinition* BeforePhase = BeforePhases.IsValidIndex(Index) ? &BeforePhases[Index] : nullptr;
+            const FEnemyPhaseDefinition* AfterPhase = AfterPhases.IsValidIndex(Index) ? &AfterPhases[Index] : nullptr;
+            if (BeforePhase && AfterPhase)
+            {
+                Writer.CompareStruct(EEnemyDiffSection::Phases, KeyToName(Index), FEnemyPhaseDefinition::StaticStruct(), BeforePhase, AfterPhase);
+            }
+            else
+            {
+                Writer.Add(EEnemyDiffSection::Phases, KeyToName(Index), GET_MEMBER_NAME_CHECKED(FEnemyPhaseDefinition, PhaseName),
+                    BeforePhase ? &BeforePhase->PhaseName : nullptr, AfterPhase ? &AfterPhase->PhaseName : nullptr);
+            }
+        }
+    }
+    
+    static const TCHAR* GetSectionName(EEnemyDiffSection Section)
+    {
+        switch (Section)
+        {
+        case EEnemyDiffSection::Identity:   return TEXT("Identity");
+        case EEnemyDiffSection::Stats:      return TEXT("Stats");
+        case EEnemyDiffSection::Scaling:    return TEXT("Scaling");
+        case EEnemyDiffSection::AIConfig:   return TEXT("AIConfig");
+        case EEnemyDiffSection::Visuals:    return TEXT("Visuals");
+        case EEnemyDiffSection::Abilities:  return TEXT("Abilities");
+        case EEnemyDiffSection::Phases:     return TEXT("Phases");
+        default:                            return TEXT("None");
+        }
+    }
+}
+
+FEnemyTemplateDiff FEnemyTemplateDiff::Compare(const FEnemyResolvedTemplate& Before, const FEnemyResolvedTemplate& After, EEnemyDiffDetail Detail)
+{
+    using namespace EnemyTemplateDiff;
+    
+    FEnemyTemplateDiff Diff;
+    if (&Before == &After)
+    {
+        return Diff;
+    }
+    
+    FDiffWriter Writer{ Diff, Detail == EEnemyDiffDetail::Fields };
+    
+    Writer.Compare(EEnemyDiffSection::Identity, NAME_None, GET_MEMBER_NAME_CHECKED(FEnemyResolvedTemplate, EnemyType), Before.EnemyType, After.EnemyType);
+    Writer.Compare(EEnemyDiffSection::Identity, NAME_None, GET_MEMBER_NAME_CHECKED(FEnemyResolvedTemplate, TemplateTags), Before.TemplateTags, After.TemplateTags);
+    
+    Writer.CompareStruct(EEnemyDiffSection::Stats, NAME_None, FEnemyBaseStats::StaticStruct(), &Before.BaseStats, &After.BaseStats);
+    
+    Writer.CompareMaps(EEnemyDiffSection::Scaling, GET_MEMBER_NAME_CHECKED(FEnemyStatScaling, StatScalingCurves), Before.StatScaling.StatScalingCurves, After.StatScaling.StatScalingCurves);
+    Writer.CompareMaps(EEnemyDiffSection::Scaling, GET_MEMBER_NAME_CHECKED(FEnemyStatScaling, DifficultyMultipliers), Before.StatScaling.DifficultyMultipliers, After.StatScaling.DifficultyMultipliers);
+    Writer.CompareMaps(EEnemyDiffSection::Scaling, GET_MEMBER_NAME_CHECKED(FEnemyStatScaling, EliteMultipliers), Before.StatScaling.EliteMultipliers, After.StatScaling.EliteMultipliers);
+    
+    // Interned facets: the same allocation means the same content
+    if (Before.AIConfig != After.AIConfig)
+    {
+        CompareAIConfig(Writer, *Before.AIConfig, *After.AIConfig);
+    }
+    
+    if (Before.Visuals != After.Visuals)
+    {
+        CompareVisuals(Writer, *Before.Visuals, *After.Visuals);
+    }
+    
+    if (Before.Abilities != After.Abilities)
+    {
+        const FEnemyAbilityTable& BeforeAbilities = *Before.Abilities;
+        const FEnemyAbilityTable& AfterAbilities = *After.Abilities;
+        DiffAbilities(BeforeAbilities, AfterAbilities, [&](FName AbilityName, int32 BeforeIndex, int32 AfterIndex)
+        {
+            if (BeforeIndex == INDEX_NONE)
+            {
+                Diff.AddedAbilities.Add(AbilityName);
+                Writer.Add(EEnemyDiffSection::Abilities, AbilityName, NAME_None, static_cast<const TSoftClassPtr<UGameplayAbility>*>(nullptr),
+                    &AfterAbilities.GetColdData(AfterAbilities.Records[AfterIndex]).AbilityClass);
+            }
+            else if (AfterIndex == INDEX_NONE)
+            {
+                Diff.RemovedAbilities.Add(AbilityName);
+                Writer.Add(EEnemyDiffSection::Abilities, AbilityName, NAME_None, &BeforeAbilities.GetColdData(BeforeAbilities.Records[BeforeIndex]).AbilityClass,
+                    static_cast<const TSoftClassPtr<UGameplayAbility>*>(nullptr));
+            }
+            else
+            {
+                Diff.ModifiedAbilities.Add(AbilityName);
+                CompareAbility(Writer, BeforeAbilities, BeforeIndex, AfterAbilities, AfterIndex);
+            }
+        });
+    }
+    
+    ComparePhases(Writer, Before, After);
+    return Diff;
+}
+
+bool FEnemyTemplateDiff::CompareTemplates(const UEnemyTemplate& Before, const UEnemyTemplate& After, FEnemyTemplateDiff& OutDiff, EEnemyDiffDetail Detail)
+{
+    const FEnemyResolvedTemplatePtr BeforeSnapshot = Before.GetResolvedTemplate();
+    const FEnemyResolvedTemplatePtr AfterSnapshot = After.GetResolvedTemplate();
+    if (!BeforeSnapshot || !AfterSnapshot)
+    {
+        return false;
+    }
+    
+    OutDiff = Compare(*BeforeSnapshot, *AfterSnapshot, Detail);
+    return true;
+}
+
+bool FEnemyTemplateDiff::CompareToParent(const UEnemyTemplate& Template, FEnemyTemplateDiff& OutDiff, EEnemyDiffDetail Detail)
+{
+    const UEnemyTemplate* Parent = Template.GetParentTemplate();
+    return Parent && CompareTemplates(*Parent, Template, OutDiff, Detail);
+}
+
+bool FEnemyTemplateDiff::CompareToBase(const UEnemyConfiguration& Configuration, FEnemyTemplateDiff& OutDiff, EEnemyDiffDetail Detail)
+{
+    const UEnemyTemplate* Template = Configuration.BaseTemplate.Get();
+    const FEnemyResolvedTemplatePtr BaseSnapshot = Template ? Template->GetResolvedTemplate() : nullptr;
+    const FEnemyResolvedTemplatePtr ConfigurationSnapshot = Configuration.GetResolvedConfiguration();
+    if (!BaseSnapshot || !ConfigurationSnapshot)
+    {
+        return false;
+    }
+    
+    OutDiff = Compare(*BaseSnapshot, *ConfigurationSnapshot, Detail);
+    return true;
+}
+
+void FEnemyTemplateDiff::DiffAbilities(const FEnemyAbilityTable& Before, const FEnemyAbilityTable& After, TFunctionRef<void(FName, int32, int32)> Visitor)
+{
+    using namespace EnemyTemplateDiff;
+    
+    if (&Before == &After)
+    {
+        return;
+    }
+    
+    FAbilityMap::Diff(MakeAbilityMap(Before), MakeAbilityMap(After), [&Visitor](FName AbilityName, const FAbilityEntry* BeforeEntry, const FAbilityEntry* AfterEntry)
+    {
+        Visitor(AbilityName, BeforeEntry ? BeforeEntry->Index : INDEX_NONE, AfterEntry ? AfterEntry->Index : INDEX_NONE);
+    });
+}
+
+FString FEnemyTemplateDiff::ToString() const
+{
+    // Keys arrive in FName order, which differs between sessions; sort lexically so the text is stable
+    TArray<const FEnemyFieldDiff*> SortedFields;
+    SortedFields.Reserve(Fields.Num());
+    for (const FEnemyFieldDiff& Field : Fields)
+    {
+        SortedFields.Add(&Field);
+    }
+    Algo::StableSort(SortedFields, [](const FEnemyFieldDiff* A, const FEnemyFieldDiff* B)
+    {
+        if (A->Section != B->Section)
+        {
+            return A->Section < B->Section;
+        }
+        if (A->Key != B->Key)
+        {
+            return A->Key.LexicalLess(B->Key);
+        }
+        return A->Field != B->Field && A->Field.LexicalLess(B->Field);
+    });
+    
+    TStringBuilder<1024> Builder;
+    for (const FEnemyFieldDiff* FieldPtr : SortedFields)
+    {
+        const FEnemyFieldDiff& Field = *FieldPtr;
+        Builder << EnemyTemplateDiff::GetSectionName(Field.Section);
+        if (!Field.Key.IsNone())
+        {
+            Builder << TEXT(" ") << Field.Key;
+        }
+        if (!Field.Field.IsNone())
+        {
+            Builder << TEXT(" ") << Field.Field;
+        }
+        Builder << TEXT(": ") << (Field.Before.IsEmpty() ? TEXT("(none)") : *Field.Before)
+            << TEXT(" -> ") << (Field.After.IsEmpty() ? TEXT("(none)") : *Field.After) << TEXT("\n");
+    }
+    return FString(Builder.ToView());
+}
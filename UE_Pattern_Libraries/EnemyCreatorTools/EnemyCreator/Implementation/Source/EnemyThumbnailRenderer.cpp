@@ -0,0 +1,602 @@
+#include "EnemyThumbnailRenderer.h"
+#include "EnemyTemplate.h"
+#include "EnemyCreatorSettings.h"
+#include "Engine/AssetManager.h"
+#include "Engine/StreamableManager.h"
+#include "Engine/Texture2D.h"
+#include "Engine/TextureRenderTarget2D.h"
+#include "Components/SkeletalMeshComponent.h"
+#include "Components/SceneCaptureComponent2D.h"
+#include "PreviewScene.h"
+#include "RenderingThread.h"
+#include "ImageUtils.h"
+#include "ImageCore.h"
+#include "Async/Async.h"
+#include "Misc/App.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+namespace EnemyThumbnailRenderer
+{
+    /** Bump when captures change in a way the content hash cannot see, such as framing or lighting */
+    static constexpr int32 CacheVersion = 1;
+    
+    /** Camera pitch and field of view for every capture; the enemy faces +X */
+    static const FRotator CaptureRotation(-15.0f, 180.0f, 0.0f);
+    static constexpr float CaptureFOV = 30.0f;
+    
+    /** Below default, so thumbnail streaming never delays a load anything else asked for */
+    static constexpr TAsyncLoadPriority LoadPriority = FStreamableManager::DefaultAsyncLoadPriority - 1;
+    
+    /** Decode a cached thumbnail. Empty if it is missing, unreadable or another size. Any thread */
+    static TArray64<FColor> ReadCachedThumbnail(const FString& Filename, int32 Size)
+    {
+        TArray64<uint8> Compressed;
+        FImage Image;
+        if (!FFileHelper::LoadFileToArray(Compressed, *Filename, FILEREAD_Silent)
+            || !FImageUtils::DecompressImage(Compressed.GetData(), Compressed.Num(), Image)
+            || Image.SizeX != Size || Image.SizeY != Size)
+        {
+            return TArray64<FColor>();
+        }
+        
+        Image.ChangeFormat(ERawImageFormat::BGRA8, EGammaSpace::sRGB);
+        const TArrayView64<FColor> Pixels = Image.AsBGRA8();
+        return TArray64<FColor>(Pixels.GetData(), Pixels.Num());
+    }
+    
+    /** Encode and store a thumbnail. Any thread */
+    static void WriteCachedThumbnail(const FString& Filename, int32 Size, const TArray64<FColor>& Pixels)
+    {
+        TArray64<uint8> Compressed;
+        FImageUtils::PNGCompressImageArray(Size, Size, Pixels, Compressed);
+        FFileHelper::SaveArrayToFile(Compressed, *Filename);
+    }
+    
+    /** Stand-in for a capture when nothing can render: the visuals' tint, so distinct visuals stay distinguishable */
+    static TArray64<FColor> MakePlaceholder(const FEnemyResolvedVisuals& Visuals, int32 Size)
+    {
+        TArray64<FColor> Pixels;
+        Pixels.Init(Visuals.ColorTint.ToFColor(true), static_cast<int64>(Size) * Size);
+        return Pixels;
+    }
+    
+    static UTexture2D* CreateThumbnailTexture(const TArray64<FColor>& Pixels, int32 Size)
+    {
+        UTexture2D* Texture = UTexture2D::CreateTransient(Size, Size, PF_B8G8R8A8);
+        if (!Texture)
+        {
+            return nullptr;
+        }
+        
+        FTexture2DMipMap& Mip = Texture->GetPlatformData()->Mips[0];
+        FMemory::Memcpy(Mip.BulkData.Lock(LOCK_READ_WRITE), Pixels.GetData(), Pixels.Num() * sizeof(FColor));
+        Mip.BulkData.Unlock();
+        Texture->UpdateResource();
+        return Texture;
+    }
+}
+
+struct FEnemyThumbnailRenderer::FCaptureScene
+{
+    explicit FCaptureScene(int32 Size)
+        : PreviewScene(FPreviewScene::ConstructionValues().SetCreatePhysicsScene(false).SetTransactional(false))
+    {
+        Target = NewObject<UTextureRenderTarget2D>(GetTransientPackage());
+        Target->ClearColor = FLinearColor::Transparent;
+        Target->InitCustomFormat(Size, Size, PF_B8G8R8A8, false);
+        
+        // Thumbnails show full quality with every mip resident, whatever the viewer's distance would pick
+        Mesh = NewObject<USkeletalMeshComponent>(GetTransientPackage());
+        Mesh->SetForcedLOD(1);
+        Mesh->SetTextureForceResidentFlag(true);
+        PreviewScene.AddComponent(Mesh, FTransform::Identity);
+        
+        Capture = NewObject<USceneCaptureComponent2D>(GetTransientPackage());
+        Capture->bCaptureEveryFrame = false;
+        Capture->bCaptureOnMovement = false;
+        Capture->CaptureSource = ESceneCaptureSource::SCS_FinalColorLDR;
+        Capture->FOVAngle = EnemyThumbnailRenderer::CaptureFOV;
+        Capture->TextureTarget = Target;
+        PreviewScene.AddComponent(Capture, FTransform::Identity);
+    }
+    
+    /** Apply visuals the way UEnemyTemplate::ApplyVisualCustomization does, frame them and start a capture */
+    void BeginCapture(const FEnemyResolvedVisuals& Visuals)
+    {
+        Mesh->SetSkeletalMesh(Visuals.SkeletalMesh.Get());
+        Mesh->EmptyOverrideMaterials();
+        for (const auto& Override : Visuals.MaterialOverrides)
+        {
+            Mesh->SetMaterial(Override.Key, Override.Value.Get());
+        }
+        Mesh->SetRelativeScale3D(Visuals.Scale);
+        
+        for (const auto& ScalarParam : Visuals.ScalarParameters)
+        {
+            Mesh->SetScalarParameterValueOnMaterials(ScalarParam.Key, ScalarParam.Value);
+        }
+        
+        for (const auto& VectorParam : Visuals.VectorParameters)
+        {
+            Mesh->SetVectorParameterValueOnMaterials(VectorParam.Key, VectorParam.Value);
+        }
+        
+        for (const auto& TextureParam : Visuals.TextureParameters)
+        {
+            if (TextureParam.Value.IsValid())
+            {
+                Mesh->SetTextureParameterValueOnMaterials(TextureParam.Key, TextureParam.Value.Get());
+            }
+        }
+        
+        // Back the camera off until the bounding sphere fills the view
+        Mesh->UpdateBounds();
+        const FBoxSphereBounds Bounds = Mesh->Bounds;
+        const float Distance = Bounds.SphereRadius / FMath::Tan(FMath::DegreesToRadians(Capture->FOVAngle * 0.5f));
+        const FRotator& Rotation = EnemyThumbnailRenderer::CaptureRotation;
+        Capture->SetWorldLocationAndRotation(Bounds.Origin - Rotation.Vector() * Distance, Rotation);
+        
+        Capture->CaptureScene();
+        CaptureFence.BeginFence();
+    }
+    
+    /** Pixels of the finished capture */
+    TArray64<FColor> ReadPixels() const
+    {
+        TArray<FColor> Pixels;
+        Target->GameThread_GetRenderTargetResource()->ReadPixels(Pixels);
+        
+        // Final color leaves alpha undefined; thumbnails are opaque
+        for (FColor& Pixel : Pixels)
+        {
+            Pixel.A = 255;
+        }
+        return TArray64<FColor>(Pixels.GetData(), Pixels.Num());
+    }
+    
+    FPreviewScene PreviewScene;
+    TObjectPtr<USkeletalMeshComponent> Mesh;
+    TObjectPtr<USceneCaptureComponent2D> Capture;
+    TObjectPtr<UTextureRenderTarget2D> Target;
+    
+    /** Passed once the render thread has executed the capture */
+    FRenderCommandFence CaptureFence;
+    
+    bool bBusy = false;
+};
+
+struct FEnemyThumbnailRenderer::FJob
+{
+    enum class EStage : uint8
+    {
+        /** Look in memory, then on disk */
+        ReadCache,
+        
+        /** Load the template to resolve its visuals */
+        LoadTemplate,
+        
+        /** Load the mesh, materials and textures the visuals refer to */
+        LoadAssets,
+        
+        /** Wait for a free scene, capture, and wait for the render thread */
+        Capture
+    };
+    
+    ~FJob()
+    {
+        if (LoadHandle.IsValid())
+        {
+            LoadHandle->CancelHandle();
+        }
+        if (Scene)
+        {
+            Scene->bBusy = false;
+        }
+    }
+    
+    EStage Stage = EStage::ReadCache;
+    
+    /** 0 until known */
+    uint64 ContentHash = 0;
+    
+    /** Template to resolve, for template requests */
+    FSoftObjectPath Template;
+    
+    /** Visuals to capture, once resolved */
+    TSharedPtr<const FEnemyResolvedVisuals, ESPMode::ThreadSafe> Visuals;
+    
+    /** Keeps the template or the captured assets loaded */
+    TSharedPtr<FStreamableHandle> LoadHandle;
+    
+    /** Decode of the cache file, on a background thread */
+    TFuture<TArray64<FColor>> CacheRead;
+    
+    /** Scene the capture is in flight in */
+    FCaptureScene* Scene = nullptr;
+    
+    /** Thumbnail produced, passed to the callbacks once the request is removed */
+    UTexture2D* Result = nullptr;
+    
+    /** Callers waiting on this request, by request id */
+    TArray<TPair<uint32, FOnEnemyThumbnailRendered>, TInlineAllocator<1>> Callbacks;
+};
+
+FEnemyThumbnailRenderer::FEnemyThumbnailRenderer()
+    : ThumbnailSize(UEnemyCreatorSettings::Get()->ThumbnailSize)
+    , bNullRenderer(!FApp::CanEverRender())
+{
+    TickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateRaw(this, &FEnemyThumbnailRenderer::Tick));
+}
+
+FEnemyThumbnailRenderer::~FEnemyThumbnailRenderer()
+{
+    FTSTicker::GetCoreTicker().RemoveTicker(TickerHandle);
+    
+    // Requests release their scenes, so they go first
+    CancelAll();
+    
+    for (const TUniquePtr<FCaptureScene>& Scene : Scenes)
+    {
+        Scene->CaptureFence.Wait();
+    }
+}
+
+UTexture2D* FEnemyThumbnailRenderer::FindThumbnail(uint64 ContentHash) const
+{
+    const TObjectPtr<UTexture2D>* Thumbnail = Thumbnails.Find(ContentHash);
+    return Thumbnail ? Thumbnail->Get() : nullptr;
+}
+
+uint32 FEnemyThumbnailRenderer::RequestTemplateThumbnail(const FSoftObjectPath& Template, uint64 ExpectedHash, FOnEnemyThumbnailRendered OnRendered)
+{
+    if (ExpectedHash != 0)
+    {
+        if (UTexture2D* Thumbnail = FindThumbnail(ExpectedHash))
+        {
+            OnRendered.ExecuteIfBound(Thumbnail);
+            return 0;
+        }
+        
+        if (FJob* Existing = JobsByHash.FindRef(ExpectedHash))
+        {
+            return AddCallback(*Existing, MoveTemp(OnRendered));
+        }
+    }
+    
+    FJob& Job = *Jobs.Add_GetRef(MakeUnique<FJob>());
+    Job.ContentHash = ExpectedHash;
+    Job.Template = Template;
+    if (ExpectedHash != 0)
+    {
+        JobsByHash.Add(ExpectedHash, &Job);
+    }
+    return AddCallback(Job, MoveTemp(OnRendered));
+}
+
+uint32 FEnemyThumbnailRenderer::RequestThumbnail(const FEnemyVisualsFacet& Visuals, FOnEnemyThumbnailRendered OnRendered)
+{
+    const uint64 ContentHash = Visuals->GetContentHash();
+    if (UTexture2D* Thumbnail = FindThumbnail(ContentHash))
+    {
+        OnRendered.ExecuteIfBound(Thumbnail);
+        return 0;
+    }
+    
+    if (FJob* Existing = JobsByHash.FindRef(ContentHash))
+    {
+        return AddCallback(*Existing, MoveTemp(OnRendered));
+    }
+    
+    FJob& Job = *Jobs.Add_GetRef(MakeUnique<FJob>());
+    Job.ContentHash = ContentHash;
+    Job.Visuals = Visuals;
+    JobsByHash.Add(ContentHash, &Job);
+    return AddCallback(Job, MoveTemp(OnRendered));
+}
+
+void FEnemyThumbnailRenderer::CancelRequest(uint32 RequestId)
+{
+    FJob* Job = nullptr;
+    if (!JobsByRequest.RemoveAndCopyValue(RequestId, Job))
+    {
+        return;
+    }
+    
+    Job->Callbacks.RemoveAll([RequestId](const TPair<uint32, FOnEnemyThumbnailRendered>& Callback) { return Callback.Key == RequestId; });
+    if (Job->Callbacks.Num() == 0)
+    {
+        RemoveJob(Jobs.IndexOfByPredicate([Job](const TUniquePtr<FJob>& Pending) { return Pending.Get() == Job; }));
+    }
+}
+
+void FEnemyThumbnailRenderer::CancelAll()
+{
+    JobsByHash.Reset();
+    JobsByRequest.Reset();
+    Jobs.Reset();
+}
+
+uint32 FEnemyThumbnailRenderer::AddCallback(FJob& Job, FOnEnemyThumbnailRendered&& OnRendered)
+{
+    const uint32 RequestId = NextRequestId++;
+    if (NextRequestId == 0)
+    {
+        NextRequestId = 1;
+    }
+    
+    Job.Callbacks.Emplace(RequestId, MoveTemp(OnRendered));
+    JobsByRequest.Add(RequestId, &Job);
+    return RequestId;
+}
+
+TUniquePtr<FEnemyThumbnailRenderer::FJob> FEnemyThumbnailRenderer::RemoveJob(int32 Index)
+{
+    TUniquePtr<FJob> Job = MoveTemp(Jobs[Index]);
+    Jobs.RemoveAt(Index);
+    
+    if (Job->ContentHash != 0 && JobsByHash.FindRef(Job->ContentHash) == Job.Get())
+    {
+        JobsByHash.Remove(Job->ContentHash);
+    }
+    for (const TPair<uint32, FOnEnemyThumbnailRendered>& Callback : Job->Callbacks)
+    {
+        JobsByRequest.Remove(Callback.Key);
+    }
+    return Job;
+}
+
+bool FEnemyThumbnailRenderer::Tick(float DeltaTime)
+{
+    const double EndTime = FPlatformTime::Seconds() + UEnemyCreatorSettings::Get()->ThumbnailBudgetMs * 0.001;
+    
+    // Newest requests first, so the rows that came into view last are served before ones already scrolled
+    // past; a callback may request or cancel, so the index is clamped to the array after every completion
+    for (int32 Index = Jobs.Num() - 1; Index >= 0 && FPlatformTime::Seconds() < EndTime; --Index)
+    {
+        if (!AdvanceJob(*Jobs[Index], EndTime))
+        {
+            continue;
+        }
+        
+        const TUniquePtr<FJob> Finished = RemoveJob(Index);
+        for (const TPair<uint32, FOnEnemyThumbnailRendered>& Callback : Finished->Callbacks)
+        {
+            Callback.Value.ExecuteIfBound(Finished->Result);
+        }
+        Index = FMath::Min(Index, Jobs.Num());
+    }
+    
+    return true;
+}
+
+bool FEnemyThumbnailRenderer::AdvanceJob(FJob& Job, double EndTime)
+{
+    using EStage = FJob::EStage;
+    
+    if (Job.Stage == EStage::ReadCache)
+    {
+        if (Job.ContentHash == 0)
+        {
+            Job.Stage = EStage::LoadTemplate;
+        }
+        else if (UTexture2D* Thumbnail = FindThumbnail(Job.ContentHash))
+        {
+            Job.Result = Thumbnail;
+            return true;
+        }
+        else if (!Job.CacheRead.IsValid())
+        {
+            Job.CacheRead = AsyncPool(*GThreadPool, [Filename = GetCacheFilename(Job.ContentHash), Size = ThumbnailSize]()
+            {
+                return EnemyThumbnailRenderer::ReadCachedThumbnail(Filename, Size);
+            }, nullptr, EQueuedWorkPriority::Lowest);
+            return false;
+        }
+        else if (!Job.CacheRead.IsReady())
+        {
+            return false;
+        }
+        else
+        {
+            TArray64<FColor> Pixels = Job.CacheRead.Consume();
+            if (Pixels.Num() > 0)
+            {
+                CompleteJob(Job, MoveTemp(Pixels), false);
+                return true;
+            }
+            Job.Stage = Job.Visuals.IsValid() ? EStage::LoadAssets : EStage::LoadTemplate;
+        }
+    }
+    
+    if (Job.Stage == EStage::LoadTemplate)
+    {
+        if (!Job.LoadHandle.IsValid())
+        {
+            Job.LoadHandle = UAssetManager::GetStreamableManager().RequestAsyncLoad(Job.Template, FStreamableDelegate(), EnemyThumbnailRenderer::LoadPriority);
+        }
+        if (Job.LoadHandle.IsValid() && !Job.LoadHandle->HasLoadCompleted())
+        {
+            return false;
+        }
+        Job.LoadHandle.Reset();
+        
+        const UEnemyTemplate* Template = Cast<UEnemyTemplate>(Job.Template.ResolveObject());
+        const FEnemyResolvedTemplatePtr Resolved = Template ? Template->GetResolvedTemplate() : nullptr;
+        if (!Resolved.IsValid())
+        {
+            return true;
+        }
+        
+        Job.Visuals = Resolved->Visuals;
+        const uint64 ContentHash = Job.Visuals->GetContentHash();
+        if (ContentHash != Job.ContentHash)
+        {
+            // The registry tag was missing or predates the last edit; look again under the current hash
+            if (Job.ContentHash != 0 && JobsByHash.FindRef(Job.ContentHash) == &Job)
+            {
+                JobsByHash.Remove(Job.ContentHash);
+            }
+            Job.ContentHash = ContentHash;
+            
+            if (FJob* Existing = JobsByHash.FindRef(ContentHash))
+            {
+                for (const TPair<uint32, FOnEnemyThumbnailRendered>& Callback : Job.Callbacks)
+                {
+                    JobsByRequest.Add(Callback.Key, Existing);
+                }
+                Existing->Callbacks.Append(MoveTemp(Job.Callbacks));
+                Job.Callbacks.Reset();
+                return true;
+            }
+            
+            JobsByHash.Add(ContentHash, &Job);
+            Job.CacheRead.Reset();
+            Job.Stage = EStage::ReadCache;
+            return false;
+        }
+        Job.Stage = EStage::LoadAssets;
+    }
+    
+    if (bNullRenderer)
+    {
+        CompleteJob(Job, EnemyThumbnailRenderer::MakePlaceholder(*Job.Visuals, ThumbnailSize), true);
+        return true;
+    }
+    
+    if (Job.Stage == EStage::LoadAssets)
+    {
+        if (!Job.LoadHandle.IsValid())
+        {
+            const FEnemyResolvedVisuals& Visuals = *Job.Visuals;
+            TArray<FSoftObjectPath> Assets;
+            Assets.Add(Visuals.SkeletalMesh.ToSoftObjectPath());
+            for (const auto& Override : Visuals.MaterialOverrides)
+            {
+                Assets.Add(Override.Value.ToSoftObjectPath());
+            }
+            for (const auto& TextureParam : Visuals.TextureParameters)
+            {
+                Assets.Add(TextureParam.Value.ToSoftObjectPath());
+            }
+            Assets.RemoveAll([](const FSoftObjectPath& Path) { return Path.IsNull(); });
+            
+            if (Assets.Num() > 0)
+            {
+                Job.LoadHandle = UAssetManager::GetStreamableManager().RequestAsyncLoad(MoveTemp(Assets), FStreamableDelegate(), EnemyThumbnailRenderer::LoadPriority);
+            }
+        }
+        if (Job.LoadHandle.IsValid() && !Job.LoadHandle->HasLoadCompleted())
+        {
+            return false;
+        }
+        Job.Stage = EStage::Capture;
+    }
+    
+    if (!Job.Scene)
+    {
+        if (FPlatformTime::Seconds() >= EndTime)
+        {
+            return false;
+        }
+        
+        if (Scenes.Num() == 0)
+        {
+            for (int32 Index = 0; Index < UEnemyCreatorSettings::Get()->NumThumbnailScenes; ++Index)
+            {
+                Scenes.Add(MakeUnique<FCaptureScene>(ThumbnailSize));
+            }
+        }
+        
+        const TUniquePtr<FCaptureScene>* FreeScene = Scenes.FindByPredicate([](const TUniquePtr<FCaptureScene>& Scene) { return !Scene->bBusy; });
+        if (!FreeScene)
+        {
+            return false;
+        }
+        
+        Job.Scene = FreeScene->Get();
+        Job.Scene->bBusy = true;
+        Job.Scene->BeginCapture(*Job.Visuals);
+        return false;
+    }
+    
+    if (!Job.Scene->CaptureFence.IsFenceComplete())
+    {
+        return false;
+    }
+    
+    TArray64<FColor> Pixels = Job.Scene->ReadPixels();
+    Job.Scene->bBusy = false;
+    Job.Scene = nullptr;
+    Job.LoadHandle.Reset();
+    CompleteJob(Job, MoveTemp(Pixels), true);
+    return true;
+}
+
+void FEnemyThumbnailRenderer::CompleteJob(FJob& Job, TArray64<FColor>&& Pixels, bool bWriteToDisk)
+{
+    if (Pixels.Num() != static_cast<int64>(ThumbnailSize) * ThumbnailSize)
+    {
+        return;
+    }
+    
+    Job.Result = EnemyThumbnailRenderer::CreateThumbnailTexture(Pixels, ThumbnailSize);
+    if (Job.Result)
+    {
+        AddThumbnail(Job.ContentHash, Job.Result);
+    }
+    
+    if (bWriteToDisk)
+    {
+        AsyncPool(*GThreadPool, [Filename = GetCacheFilename(Job.ContentHash), Size = ThumbnailSize, Pixels = MoveTemp(Pixels)]()
+        {
+            EnemyThumbnailRenderer::WriteCachedThumbnail(Filename, Size, Pixels);
+        }, nullptr, EQueuedWorkPriority::Lowest);
+    }
+}
+
+void FEnemyThumbnailRenderer::AddThumbnail(uint64 ContentHash, UTexture2D* Thumbnail)
+{
+    if (TObjectPtr<UTexture2D>* Existing = Thumbnails.Find(ContentHash))
+    {
+        *Existing = Thumbnail;
+        return;
+    }
+    
+    Thumbnails.Add(ContentHash, Thumbnail);
+    ThumbnailOrder.Add(ContentHash);
+    
+    const int32 MaxCachedThumbnails = UEnemyCreatorSettings::Get()->MaxCachedThumbnails;
+    if (ThumbnailOrder.Num() > MaxCachedThumbnails)
+    {
+        const int32 NumReleased = ThumbnailOrder.Num() - MaxCachedThumbnails;
+        for (int32 Index = 0; Index < NumReleased; ++Index)
+        {
+            Thumbnails.Remove(ThumbnailOrder[Index]);
+        }
+        ThumbnailOrder.RemoveAt(0, NumReleased, false);
+    }
+}
+
+FString FEnemyThumbnailRenderer::GetCacheFilename(uint64 ContentHash) const
+{
+    // Placeholders live apart so a headless run never hides real captures
+    const FString CacheName = FString::Printf(TEXT("%s_%d_v%d"), bNullRenderer ? TEXT("Null") : TEXT("Scene"), ThumbnailSize, EnemyThumbnailRenderer::CacheVersion);
+    return FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("EnemyThumbnails"), CacheName, FString::Printf(TEXT("%016llx.png"), ContentHash));
+}
+
+void FEnemyThumbnailRenderer::AddReferencedObjects(FReferenceCollector& Collector)
+{
+    Collector.AddReferencedObjects(Thumbnails);
+    for (const TUniquePtr<FCaptureScene>& Scene : Scenes)
+    {
+        Collector.AddReferencedObject(Scene->Mesh);
+        Collector.AddReferencedObject(Scene->Capture);
+        Collector.AddReferencedObject(Scene->Target);
+    }
+}
+
+FString FEnemyThumbnailRenderer::GetReferencerName() const
+{
+    return TEXT("FEnemyThumbnailRenderer");
+}
@@ -0,0 +1,86 @@
+#include "EnemyTraitMask.h"
+#include "EnemyCreatorSettings.h"
+
+FEnemyTraitMask FEnemyTraitMask::ForTag(const FGameplayTag& Tag)
+{
+    const TArray<FGameplayTag>& TraitTags = UEnemyCreatorSettings::Get()->TraitTags;
+    const int32 NumTagBits = FMath::Min(TraitTags.Num(), EnemyTraitBits::MaxTagBits);
+    for (int32 Index = 0; Index < NumTagBits; ++Index)
+    {
+        if (TraitTags[Index] == Tag)
+        {
+            return ForBit(EnemyTraitBits::FirstTagBit + Index);
+        }
+    }
+
+    return FEnemyTraitMask();
+}
+
+FEnemyTraitMask FEnemyTraitMask::ForTags(const FGameplayTagContainer& Tags)
+{
+    FEnemyTraitMask Mask;
+    if (Tags.IsEmpty())
+    {
+        return Mask;
+    }
+
+    const TArray<FGameplayTag>& TraitTags = UEnemyCreatorSettings::Get()->TraitTags;
+    const int32 NumTagBits = FMath::Min(TraitTags.Num(), EnemyTraitBits::MaxTagBits);
+    for (int32 Index = 0; Index < NumTagBits; ++Index)
+    {
+        if (Tags.HasTag(TraitTags[Index]))
+        {
+            Mask |= ForBit(EnemyTraitBits::FirstTagBit + Index);
+        }
+    }
+
+    return Mask;
+}
+
+FEnemyTraitMask FEnemyTraitMask::Build(EEnemyType Type, bool bUseCover, bool bCoordinateWithAllies, bool bHasPassiveAbility, bool bEmitsAura, const FGameplayTagContainer& Tags)
+{
+    FEnemyTraitMask Mask = ForType(Type) | ForTags(Tags);
+    if (bUseCover)
+    {
+        Mask |= ForBit(EnemyTraitBits::UseCover);
+    }
+    if (bCoordinateWithAllies)
+    {
+        Mask |= ForBit(EnemyTraitBits::CoordinateWithAllies);
+    }
+    if (bHasPassiveAbility)
+    {
+        Mask |= ForBit(EnemyTraitBits::HasPassiveAbility);
+    }
+    if (bEmitsAura)
+    {
+        Mask |= ForBit(EnemyTraitBits::EmitsAura);
+    }
+    return Mask;
+}
+
+namespace EnemyTraitMask
+{
+    void Filter(TArrayView<const uint64> Masks, FEnemyTraitMask Required, FEnemyTraitMask Excluded, TArray<int32>& OutIndices)
+    {
+        const uint64 RequiredBits = Required.Bits;
+        const uint64 ExcludedBits = Excluded.Bits;
+        const uint64* RESTRICT Data = Masks.GetData();
+        const int32 Num = Masks.Num();
+
+        OutIndices.Reset();
+        OutIndices.AddUninitialized(Num);
+        int32* RESTRICT Out = OutIndices.GetData();
+
+        // Always write, advance only on match: no data-dependent branch in the loop body
+        int32 NumMatches = 0;
+        for (int32 Index = 0; Index < Num; ++Index)
+        {
+            const uint64 Mask = Data[Index];
+            Out[NumMatches] = Index;
+            NumMatches += static_cast<int32>(((Mask & RequiredBits) == RequiredBits) & ((Mask & ExcludedBits) == 0));
+        }
+
+        OutIndices.SetNum(NumMatches, false);
+    }
+}
@@ -0,0 +1,132 @@
+#include "EnemyTypeTraits.h"
+#include "EnemyTemplateBuilder.h"
+
+void TEnemyTypeTraits<EEnemyType::Melee>::AddDefaultAbilities(FEnemyTemplateBuilder& Builder)
+{
+    Builder.EmplaceAbility(TEXT("Charge"),
+        NSLOCTEXT("EnemyAbilities", "Charge", "Charge Attack"),
+        NSLOCTEXT("EnemyAbilities", "ChargeDesc", "Charge towards target and deal damage"),
+        8.0f, 600.0f);
+    Builder.EmplaceAbility(TEXT("Cleave"),
+        NSLOCTEXT("EnemyAbilities", "Cleave", "Cleaving Strike"),
+        NSLOCTEXT("EnemyAbilities", "CleaveDesc", "Wide sweeping attack that hits multiple targets"),
+        5.0f, 250.0f);
+}
+
+void TEnemyTypeTraits<EEnemyType::Ranged>::AddDefaultAbilities(FEnemyTemplateBuilder& Builder)
+{
+    Builder.EmplaceAbility(TEXT("PowerShot"),
+        NSLOCTEXT("EnemyAbilities", "PowerShot", "Power Shot"),
+        NSLOCTEXT("EnemyAbilities", "PowerShotDesc", "Charged shot that deals high damage"),
+        10.0f, 1000.0f);
+    Builder.EmplaceAbility(TEXT("Volley"),
+        NSLOCTEXT("EnemyAbilities", "Volley", "Arrow Volley"),
+        NSLOCTEXT("EnemyAbilities", "VolleyDesc", "Fire multiple projectiles in an area"),
+        15.0f, 800.0f);
+}
+
+void TEnemyTypeTraits<EEnemyType::Support>::AddDefaultAbilities(FEnemyTemplateBuilder& Builder)
+{
+    FEnemyAbilityDefinition& Heal = Builder.EmplaceAbility(TEXT("Heal"),
+        NSLOCTEXT("EnemyAbilities", "Heal", "Healing Pulse"),
+        NSLOCTEXT("EnemyAbilities", "HealDesc", "Heal nearby allies"),
+        12.0f, 500.0f);
+    Heal.AuraType = EEnemyAuraType::Heal;
+    Heal.AuraMagnitude = 10.0f;
+    
+    FEnemyAbilityDefinition& Buff = Builder.EmplaceAbility(TEXT("Buff"),
+        NSLOCTEXT("EnemyAbilities", "Buff", "Battle Cry"),
+        NSLOCTEXT("EnemyAbilities", "BuffDesc", "Increase damage of nearby allies"),
+        20.0f, 600.0f);
+    Buff.AuraType = EEnemyAuraType::Buff;
+    Buff.AuraMagnitude = 0.1f;
+}
+
+void TEnemyTypeTraits<EEnemyType::Elite>::AddDefaultAbilities(FEnemyTemplateBuilder& Builder)
+{
+    Builder.EmplaceAbility(TEXT("Ultimate"),
+        NSLOCTEXT("EnemyAbilities", "Ultimate", "Elite Power"),
+        NSLOCTEXT("EnemyAbilities", "UltimateDesc", "Powerful ability unique to this elite enemy"),
+        30.0f, 400.0f);
+}
+
+void TEnemyTypeTraits<EEnemyType::Boss>::AddDefaultAbilities(FEnemyTemplateBuilder& Builder)
+{
+    Builder.EmplaceAbility(TEXT("Phase1"),
+        NSLOCTEXT("EnemyAbilities", "Phase1", "Phase 1 Ultimate"),
+        NSLOCTEXT("EnemyAbilities", "Phase1Desc", "First phase special ability"),
+        45.0f, 1000.0f);
+    
+    // The second ultimate unlocks at half health
+    FEnemyPhaseDefinition& Phase2 = Builder.EmplacePhase(TEXT("Phase2"), 0.5f);
+    FEnemyAbilityDefinition& Phase2Ultimate = Phase2.Abilities.Emplace_GetRef();
+    Phase2Ultimate.AbilityName = TEXT("Phase2");
+    Phase2Ultimate.DisplayName = NSLOCTEXT("EnemyAbilities", "Phase2", "Phase 2 Ultimate");
+    Phase2Ultimate.Description = NSLOCTEXT("EnemyAbilities", "Phase2Desc", "Second phase special ability");
+    Phase2Ultimate.CooldownTime = 60.0f;
+    Phase2Ultimate.Range = 1000.0f;
+}
+
+namespace EnemyTypeTraits
+{
+    template <EEnemyType Type>
+    struct TInitializeDefaults
+    {
+        static void Invoke(FEnemyTemplateBuilder& Builder)
+        {
+            constexpr const FEnemyTypeDefaults& Defaults = TEnemyTypeTraits<Type>::Defaults;
+            
+            FEnemyBaseStats& BaseStats = Builder.EditBaseStats();
+            BaseStats.Health = Defaults.Health;
+            BaseStats.Damage = Defaults.Damage;
+            BaseStats.Speed = Defaults.Speed;
+            BaseStats.AttackSpeed = Defaults.AttackSpeed;
+            BaseStats.Defense = Defaults.Defense;
+            BaseStats.CriticalChance = Defaults.CriticalChance;
+            BaseStats.CriticalMultiplier = Defaults.CriticalMultiplier;
+            
+            FEnemyAIConfig& AIConfig = Builder.EditAIConfig();
+            AIConfig.AggressionLevel = Defaults.AggressionLevel;
+            AIConfig.PreferredRange = Defaults.PreferredRange;
+            AIConfig.bUseCover = Defaults.bUseCover;
+            AIConfig.bCoordinateWithAllies = Defaults.bCoordinateWithAllies;
+            
+            Builder.EditVisuals().Scale = FVector(Defaults.VisualScale);
+        }
+    };
+    
+    template <EEnemyType Type>
+    struct TAddDefaultAbilities
+    {
+        static void Invoke(FEnemyTemplateBuilder& Builder)
+        {
+            Builder.EmplaceAbility(TEXT("BasicAttack"),
+                NSLOCTEXT("EnemyAbilities", "BasicAttack", "Basic Attack"),
+                NSLOCTEXT("EnemyAbilities", "BasicAttackDesc", "Basic melee or ranged attack"),
+                1.0f, TEnemyTypeTraits<Type>::Defaults.BasicAttackRange);
+            
+            TEnemyTypeTraits<Type>::AddDefaultAbilities(Builder);
+        }
+    };
+    
+    void InitializeDefaults(FEnemyTemplateBuilder& Builder, EEnemyType Type)
+    {
+        TEnemyTypeDispatchTable<void (*)(FEnemyTemplateBuilder&), TInitializeDefaults>::Get(Type)(Builder);
+    }
+    
+    void AddDefaultAbilities(FEnemyTemplateBuilder& Builder, EEnemyType Type)
+    {
+        TEnemyTypeDispatchTable<void (*)(FEnemyTemplateBuilder&), TAddDefaultAbilities>::Get(Type)(Builder);
+    }
+    
+    template <EEnemyType Type>
+    struct THasAuras
+    {
+        static bool Invoke() { return TEnemyTypeTraits<Type>::bHasAuras; }
+    };
+    
+    bool HasAuras(EEnemyType Type)
+    {
+        return TEnemyTypeDispatchTable<bool (*)(), THasAuras>::Get(Type)();
+    }
+}
@@ -0,0 +1,330 @@
+#include "EnemyVisualLODComponent.h"
+#include "EnemyAnimationSharing.h"
+#include "EnemyCreatorSettings.h"
+#include "GameFramework/Character.h"
+#include "Components/SkeletalMeshComponent.h"
+#include "Components/StaticMeshComponent.h"
+#include "Materials/MaterialInstanceDynamic.h"
+#include "Engine/AssetManager.h"
+#include "Engine/StreamableManager.h"
+#include "SignificanceManager.h"
+#include "AnimationSharingManager.h"
+
+namespace EnemyVisualLOD
+{
+    static const FName SignificanceTag(TEXT("EnemyVisualLOD"));
+}
+
+UEnemyVisualLODComponent::UEnemyVisualLODComponent()
+{
+    // Significance callbacks drive every transition; nothing here needs a tick
+    PrimaryComponentTick.bCanEverTick = false;
+}
+
+void UEnemyVisualLODComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+    if (bAnimationShared)
+    {
+        SetAnimationShared(false);
+    }
+    UnregisterSignificance();
+    TierAssetsHandle.Reset();
+    
+    Super::EndPlay(EndPlayReason);
+}
+
+void UEnemyVisualLODComponent::SetVisuals(const FEnemyVisualsFacet& InVisuals)
+{
+    ResetVisuals();
+    
+    const ACharacter* Character = Cast<ACharacter>(GetOwner());
+    USkeletalMeshComponent* MeshComponent = Character ? Character->GetMesh() : nullptr;
+    if (!MeshComponent || InVisuals->LODTiers.Num() == 0)
+    {
+        return;
+    }
+    
+    Visuals = InVisuals;
+    BaseMaterials = MeshComponent->GetMaterials();
+    BaseAnimClass = MeshComponent->GetAnimClass();
+    TierMaterials.SetNumZeroed(Visuals->LODTiers.Num());
+    
+    // Stream every tier's assets up front so a transition never waits on a load
+    TArray<FSoftObjectPath> PendingAssets;
+    for (const FEnemyVisualLODTier& Tier : Visuals->LODTiers)
+    {
+        if (Tier.Material.IsPending())
+        {
+            PendingAssets.Add(Tier.Material.ToSoftObjectPath());
+        }
+        if (Tier.AnimClass.IsPending())
+        {
+            PendingAssets.Add(Tier.AnimClass.ToSoftObjectPath());
+        }
+        if (Tier.ImposterMesh.IsPending())
+        {
+            PendingAssets.Add(Tier.ImposterMesh.ToSoftObjectPath());
+        }
+        if (Tier.bShareAnimation && UEnemyCreatorSettings::Get()->AnimationSharingSetup.IsPending())
+        {
+            PendingAssets.AddUnique(UEnemyCreatorSettings::Get()->AnimationSharingSetup.ToSoftObjectPath());
+        }
+    }
+    
+    if (PendingAssets.Num() > 0)
+    {
+        TierAssetsHandle = UAssetManager::GetStreamableManager().RequestAsyncLoad(MoveTemp(PendingAssets));
+    }
+    
+    RegisterSignificance();
+}
+
+void UEnemyVisualLODComponent::ResetVisuals()
+{
+    SetTier(INDEX_NONE);
+    UnregisterSignificance();
+    
+    Visuals.Reset();
+    BaseMaterials.Reset();
+    BaseAnimClass = nullptr;
+    TierMaterials.Reset();
+    TierAssetsHandle.Reset();
+}
+
+void UEnemyVisualLODComponent::SetTier(int32 TierIndex)
+{
+    if (TierIndex == ActiveTier || !Visuals)
+    {
+        return;
+    }
+    
+    const ACharacter* Character = Cast<ACharacter>(GetOwner());
+    USkeletalMeshComponent* MeshComponent = Character ? Character->GetMesh() : nullptr;
+    if (!MeshComponent)
+    {
+        return;
+    }
+    
+    const FEnemyVisualLODTier* Tier = Visuals->LODTiers.IsValidIndex(TierIndex) ? &Visuals->LODTiers[TierIndex] : nullptr;
+    if (Tier && !IsTierLoaded(*Tier))
+    {
+        return;
+    }
+    
+    // Materials: one cached instance for every slot, or the captured full-quality set
+    if (UMaterialInstanceDynamic* TierMaterial = Tier && !Tier->Material.IsNull() ? GetOrCreateTierMaterial(TierIndex) : nullptr)
+    {
+        for (int32 SlotIndex = 0; SlotIndex < BaseMaterials.Num(); ++SlotIndex)
+        {
+            MeshComponent->SetMaterial(SlotIndex, TierMaterial);
+        }
+    }
+    else
+    {
+        for (int32 SlotIndex = 0; SlotIndex < BaseMaterials.Num(); ++SlotIndex)
+        {
+            if (MeshComponent->GetMaterial(SlotIndex) != BaseMaterials[SlotIndex])
+            {
+                MeshComponent->SetMaterial(SlotIndex, BaseMaterials[SlotIndex]);
+            }
+        }
+    }
+    
+    const bool bUseImposter = Tier && !Tier->ImposterMesh.IsNull();
+    
+    // Animation: swapping the class reinitializes the instance, so only do it when the class changes
+    const TSubclassOf<UAnimInstance> AnimClass = Tier && !Tier->AnimClass.IsNull() ? Tier->AnimClass.Get() : BaseAnimClass.Get();
+    if (AnimClass && MeshComponent->GetAnimClass() != AnimClass)
+    {
+        MeshComponent->SetAnimInstanceClass(AnimClass);
+    }
+    MeshComponent->SetDisablePostProcessBlueprint(Tier && Tier->bDisablePostProcessGraph);
+    
+    // Sharing: copy a leader's pose instead of evaluating this instance's graph. Imposters do not animate at all
+    const bool bShareAnimation = Tier && Tier->bShareAnimation && !bUseImposter;
+    if (bShareAnimation != bAnimationShared)
+    {
+        SetAnimationShared(bShareAnimation);
+    }
+    
+    // Representation: an imposter replaces the skeletal mesh and stops its animation entirely
+    if (bUseImposter)
+    {
+        UStaticMeshComponent* Imposter = GetOrCreateImposter();
+        Imposter->SetStaticMesh(Tier->ImposterMesh.Get());
+        Imposter->SetVisibility(true);
+    }
+    else if (ImposterComponent)
+    {
+        ImposterComponent->SetVisibility(false);
+    }
+    MeshComponent->SetVisibility(!bUseImposter);
+    MeshComponent->bNoSkeletonUpdate = bUseImposter;
+    MeshComponent->SetComponentTickEnabled(!bUseImposter);
+    
+    ActiveTier = TierIndex;
+}
+
+float UEnemyVisualLODComponent::CalculateSignificance(const FTransform& Viewpoint) const
+{
+    const AActor* Owner = GetOwner();
+    if (!Owner)
+    {
+        return 0.0f;
+    }
+    
+    const double Distance = FVector::Dist(Owner->GetActorLocation(), Viewpoint.GetLocation());
+    return FMath::Clamp(1.0f - static_cast<float>(Distance / SignificanceDistance), 0.0f, 1.0f);
+}
+
+int32 UEnemyVisualLODComponent::SelectTier(float Significance) const
+{
+    if (!Visuals)
+    {
+        return INDEX_NONE;
+    }
+    
+    // Farthest tier whose threshold the significance is at or below; thresholds decrease along the array
+    int32 TierIndex = INDEX_NONE;
+    for (int32 Index = 0; Index < Visuals->LODTiers.Num() && Significance <= Visuals->LODTiers[Index].MaxSignificance; ++Index)
+    {
+        TierIndex = Index;
+    }
+    
+    // Moving nearer has to clear the current tier's threshold by the hysteresis margin
+    if (TierIndex < ActiveTier && Significance <= Visuals->LODTiers[ActiveTier].MaxSignificance + Hysteresis)
+    {
+        return ActiveTier;
+    }
+    
+    return TierIndex;
+}
+
+bool UEnemyVisualLODComponent::IsTierLoaded(const FEnemyVisualLODTier& Tier)
+{
+    return (Tier.Material.IsNull() || Tier.Material.IsValid())
+        && (Tier.AnimClass.IsNull() || Tier.AnimClass.IsValid())
+        && (Tier.ImposterMesh.IsNull() || Tier.ImposterMesh.IsValid());
+}
+
+UMaterialInstanceDynamic* UEnemyVisualLODComponent::GetOrCreateTierMaterial(int32 TierIndex)
+{
+    if (TierMaterials[TierIndex])
+    {
+        return TierMaterials[TierIndex];
+    }
+    
+    UMaterialInterface* ParentMaterial = Visuals->LODTiers[TierIndex].Material.Get();
+    if (!ParentMaterial)
+    {
+        return nullptr;
+    }
+    
+    UMaterialInstanceDynamic* TierMaterial = UMaterialInstanceDynamic::Create(ParentMaterial, this);
+    for (const auto& ScalarParam : Visuals->ScalarParameters)
+    {
+        TierMaterial->SetScalarParameterValue(ScalarParam.Key, ScalarParam.Value);
+    }
+    
+    for (const auto& VectorParam : Visuals->VectorParameters)
+    {
+        TierMaterial->SetVectorParameterValue(VectorParam.Key, VectorParam.Value);
+    }
+    
+    for (const auto& TextureParam : Visuals->TextureParameters)
+    {
+        if (TextureParam.Value.IsValid())
+        {
+            TierMaterial->SetTextureParameterValue(TextureParam.Key, TextureParam.Value.Get());
+        }
+    }
+    
+    TierMaterials[TierIndex] = TierMaterial;
+    return TierMaterial;
+}
+
+UStaticMeshComponent* UEnemyVisualLODComponent::GetOrCreateImposter()
+{
+    if (!ImposterComponent)
+    {
+        const ACharacter* Character = CastChecked<ACharacter>(GetOwner());
+        
+        ImposterComponent = NewObject<UStaticMeshComponent>(GetOwner(), TEXT("EnemyImposter"));
+        ImposterComponent->SetupAttachment(Character->GetMesh());
+        ImposterComponent->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+        ImposterComponent->SetCastShadow(false);
+        ImposterComponent->RegisterComponent();
+    }
+    
+    return ImposterComponent;
+}
+
+void UEnemyVisualLODComponent::SetAnimationShared(bool bShared)
+{
+    ACharacter* Character = Cast<ACharacter>(GetOwner());
+    UAnimationSharingManager* SharingManager = FEnemyAnimationSharing::GetManager(GetWorld());
+    if (!Character || !SharingManager)
+    {
+        bAnimationShared = false;
+        return;
+    }
+    
+    USkeletalMeshComponent* MeshComponent = Character->GetMesh();
+    if (bShared)
+    {
+        const USkeletalMesh* Mesh = MeshComponent ? MeshComponent->GetSkeletalMeshAsset() : nullptr;
+        if (!Mesh)
+        {
+            return;
+        }
+        SharingManager->RegisterActorWithSkeletonBP(Character, Mesh->GetSkeleton());
+    }
+    else
+    {
+        SharingManager->UnregisterActor(Character);
+        if (MeshComponent)
+        {
+            MeshComponent->SetLeaderPoseComponent(nullptr);
+        }
+    }
+    
+    bAnimationShared = bShared;
+}
+
+void UEnemyVisualLODComponent::RegisterSignificance()
+{
+    USignificanceManager* SignificanceManager = USignificanceManager::Get(GetWorld());
+    if (!SignificanceManager || bSignificanceRegistered || !GetOwner())
+    {
+        return;
+    }
+    
+    // The owner is registered rather than this component so the animation sharing manager finds its significance
+    SignificanceManager->RegisterObject(GetOwner(), EnemyVisualLOD::SignificanceTag,
+        [this](USignificanceManager::FManagedObjectInfo* ObjectInfo, const FTransform& Viewpoint)
+        {
+            return CalculateSignificance(Viewpoint);
+        },
+        USignificanceManager::EPostSignificanceType::Sequential,
+        [this](USignificanceManager::FManagedObjectInfo* ObjectInfo, float OldSignificance, float Significance, bool bFinal)
+        {
+            SetTier(SelectTier(Significance));
+        });
+    
+    bSignificanceRegistered = true;
+}
+
+void UEnemyVisualLODComponent::UnregisterSignificance()
+{
+    if (!bSignificanceRegistered)
+    {
+        return;
+    }
+    
+    if (USignificanceManager* SignificanceManager = USignificanceManager::Get(GetWorld()))
+    {
+        SignificanceManager->UnregisterObject(GetOwner());
+    }
+    
+    bSignificanceRegistered = false;
+}